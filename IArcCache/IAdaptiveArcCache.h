@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "../ICacheKey.h"
+#include "../ICachePolicy.h"
+#include "../ICacheStats.h"
+#include "IArcGhostList.h"
+
+namespace IncreCache {
+// 按论文实现的 ARC（Megiddo & Modha, FAST'03）：
+// T1 保存只访问过一次的条目，T2 保存访问过至少两次的条目，
+// B1/B2 分别记录从 T1/T2 淘汰的键的指纹（不存值），
+// 目标值 p 根据幽灵命中在 T1 与 T2 之间自适应调整。
+// 四个链表由同一把锁保护，每次操作只加锁一次
+template <typename Key, typename Value>
+class IAdaptiveArcCache
+    : public ICachePolicyAdapter<IAdaptiveArcCache<Key, Value>, Key, Value> {
+   public:
+    explicit IAdaptiveArcCache(size_t capacity = 10)
+        : capacity_(capacity),
+          target_(0),
+          b1_(capacity),
+          b2_(2 * capacity) {}
+
+    ~IAdaptiveArcCache() override = default;
+
+    // 插入或更新，右值 value 直接移动到条目中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return;
+        }
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            // 情况 I：缓存命中，更新值并移动到 T2 的最近端
+            it->second.iter->value = std::forward<V>(value);
+            promote(it->second);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        insertMissing(key, std::forward<V>(value));
+    }
+
+    // 键不存在时用 args 构造 value 并插入，返回是否插入；
+    // 键已存在时不做任何修改（也不视为一次访问）
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return false;
+        }
+        if (entries_.find(key) != entries_.end()) {
+            return false;
+        }
+        insertMissing(key, Value(std::forward<Args>(args)...));
+        return true;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            stats_.record(StatCounter::Misses);
+            return false;
+        }
+        value = it->second.iter->value;
+        promote(it->second);
+        stats_.record(StatCounter::Hits);
+        return true;
+    }
+
+    // 读取 value，不把条目移入 T2，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return false;
+        }
+        value = it->second.iter->value;
+        return true;
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = entries_.size();
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 四个链表的长度和目标值 p，用于观察自适应过程
+    struct ListSizes {
+        size_t t1;
+        size_t t2;
+        size_t b1;
+        size_t b2;
+        size_t target;
+    };
+
+    ListSizes listSizes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ListSizes{t1_.size(), t2_.size(), b1_.size(), b2_.size(),
+                         target_};
+    }
+
+    // 在线调整容量 c（见 kResizeEvictionStep），目标值 p 按新旧容量等比例缩放，
+    // 幽灵链表的上限随之调整。分批淘汰通过 REPLACE 进行，被淘汰的键照常进入
+    // 幽灵链表
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        target_ = capacity_ > 0 ? target_ * capacity / capacity_ : 0;
+        capacity_ = capacity;
+        b1_.setCapacity(capacity);
+        b2_.setCapacity(2 * capacity);
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+   private:
+    struct Entry {
+        Key key;
+        Value value;
+    };
+
+    using EntryList = std::list<Entry>;
+    using GhostList = ArcGhostList<Key>;
+
+    struct EntryLoc {
+        bool inT2;
+        typename EntryList::iterator iter;
+    };
+
+    // 未命中缓存时的插入（情况 II ~ IV），调用方已持有锁
+    template <typename V>
+    void insertMissing(const Key& key, V&& value) {
+        stats_.record(StatCounter::Puts);
+        bool inB1 = b1_.contains(key);
+        if (inB1 || b2_.contains(key)) {
+            bool inB2 = !inB1;
+            stats_.record(StatCounter::GhostHits);
+            adaptTarget(inB2);
+            ghostList(inB2).take(key);
+            if (t1_.size() + t2_.size() >= capacity_) {
+                replace(inB2);
+            }
+            // 幽灵命中说明该键被访问过不止一次，直接进入 T2
+            insertEntry(t2_, true, key, std::forward<V>(value));
+            return;
+        }
+        // 情况 IV：完全未命中
+        if (t1_.size() + b1_.size() >= capacity_) {
+            if (t1_.size() < capacity_) {
+                removeOldestGhost(false);
+                if (t1_.size() + t2_.size() >= capacity_) {
+                    replace(false);
+                }
+            } else {
+                // B1 为空且 T1 已占满整个缓存，直接丢弃 T1 最久未访问的条目
+                dropOldestEntry(t1_);
+            }
+        } else {
+            size_t total = t1_.size() + t2_.size() + b1_.size() + b2_.size();
+            if (total >= capacity_) {
+                if (total >= 2 * capacity_) {
+                    removeOldestGhost(true);
+                }
+                if (t1_.size() + t2_.size() >= capacity_) {
+                    replace(false);
+                }
+            }
+        }
+        insertEntry(t1_, false, key, std::forward<V>(value));
+    }
+
+    // 缩容后从 T1/T2 淘汰至多 kResizeEvictionStep 个超额条目
+    void shrinkStep() {
+        for (size_t n = 0;
+             n < kResizeEvictionStep && t1_.size() + t2_.size() > capacity_;
+             ++n) {
+            replace(false);
+        }
+    }
+
+    // 链表头部为最久未访问端，尾部为最近访问端
+    EntryList& entryList(bool inT2) { return inT2 ? t2_ : t1_; }
+
+    GhostList& ghostList(bool inB2) { return inB2 ? b2_ : b1_; }
+
+    template <typename V>
+    void insertEntry(EntryList& list, bool inT2, const Key& key, V&& value) {
+        list.push_back(Entry{key, std::forward<V>(value)});
+        entries_[key] = EntryLoc{inT2, std::prev(list.end())};
+    }
+
+    // 命中的条目移动到 T2 的最近端
+    void promote(EntryLoc& loc) {
+        t2_.splice(t2_.end(), entryList(loc.inT2), loc.iter);
+        loc.inT2 = true;
+    }
+
+    // 幽灵命中时调整目标值 p：B1 命中说明 T1 过小，B2 命中说明 T2 过小
+    void adaptTarget(bool inB2) {
+        if (!inB2) {
+            size_t delta =
+                b1_.size() >= b2_.size() ? 1 : b2_.size() / b1_.size();
+            target_ = std::min(capacity_, target_ + delta);
+        } else {
+            size_t delta =
+                b2_.size() >= b1_.size() ? 1 : b1_.size() / b2_.size();
+            target_ = target_ > delta ? target_ - delta : 0;
+        }
+    }
+
+    // REPLACE：根据目标值 p 从 T1 或 T2 淘汰一个条目，键进入对应的幽灵链表
+    void replace(bool hitInB2) {
+        if (!t1_.empty() &&
+            (t1_.size() > target_ || (hitInB2 && t1_.size() == target_))) {
+            demoteOldest(t1_, false);
+        } else if (!t2_.empty()) {
+            demoteOldest(t2_, true);
+        } else if (!t1_.empty()) {
+            demoteOldest(t1_, false);
+        }
+    }
+
+    void demoteOldest(EntryList& list, bool fromT2) {
+        auto oldest = list.begin();
+        ghostList(fromT2).push(oldest->key);
+        entries_.erase(oldest->key);
+        // 值随条目一起释放，幽灵链表只保留键的指纹
+        list.erase(oldest);
+        stats_.record(StatCounter::Evictions);
+    }
+
+    void dropOldestEntry(EntryList& list) {
+        auto oldest = list.begin();
+        entries_.erase(oldest->key);
+        list.erase(oldest);
+        stats_.record(StatCounter::Evictions);
+    }
+
+    void removeOldestGhost(bool fromB2) { ghostList(fromB2).popOldest(); }
+
+   private:
+    size_t capacity_;  // 缓存容量 c
+    size_t target_;    // T1 的目标大小 p
+    std::mutex mutex_;
+    StatsRecorder stats_;  // 命中、淘汰等统计计数
+
+    EntryList t1_;  // 最近只访问过一次的条目
+    EntryList t2_;  // 最近访问过至少两次的条目
+    GhostList b1_;  // 从 T1 淘汰的键，|T1| + |B1| <= c
+    GhostList b2_;  // 从 T2 淘汰的键，|B2| < 2c
+    IndexMap<Key, EntryLoc> entries_;  // T1/T2 的索引
+};
+}  // namespace IncreCache
@@ -2,75 +2,166 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
+#include <utility>
 
+#include "../ICacheKey.h"
 #include "../ICachePolicy.h"
+#include "../ICacheStats.h"
+#include "../ICacheWeigher.h"
 #include "IArcLfuPart.h"
 #include "IArcLruPart.h"
 
 namespace IncreCache {
 template <typename Key, typename Value>
-class IArcCache : public ICachePolicy<Key, Value> {
+class IArcCache
+    : public ICachePolicyAdapter<IArcCache<Key, Value>, Key, Value> {
    public:
+    using Weigher = CacheWeigher<Key, Value>;
+
     explicit IArcCache(size_t capacity = 10, size_t transformThreshold = 2)
         : capacity_(capacity),
           transformThreshold_(transformThreshold),
+          weighted_(false),
+          lruPart_(std::make_unique<ArcLruPart<Key, Value>>(
+              capacity, transformThreshold, stats_)),
+          lfuPart_(std::make_unique<ArcLfuPart<Key, Value>>(
+              capacity, transformThreshold, stats_)) {}
+
+    // 按字节预算限制容量：maxWeight 在两个部分之间平分，幽灵命中时以被让出
+    // 部分条目的平均权重为单位在两部分之间调整，两部分的总权重始终不超过
+    // maxWeight（同时存在于两部分的键计两次）。单个条目的权重超过所在部分的
+    // 预算时不缓存；幽灵链表随现存条目数按需增长
+    IArcCache(size_t maxWeight, Weigher weigher, size_t transformThreshold = 2)
+        : capacity_(maxWeight),
+          transformThreshold_(transformThreshold),
+          weighted_(true),
           lruPart_(std::make_unique<ArcLruPart<Key, Value>>(
-              capacity, transformThreshold)),
+              maxWeight / 2, transformThreshold, stats_, weigher)),
           lfuPart_(std::make_unique<ArcLfuPart<Key, Value>>(
-              capacity, transformThreshold)) {}
+              maxWeight - maxWeight / 2, transformThreshold, stats_,
+              weigher)) {}
 
     ~IArcCache() override = default;
 
-    void put(Key key, Value value) override {
+    // 插入或更新；两个部分都要写入时 LFU 部分得到副本，LRU 部分得到移动后的值
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
         checkGhostCaches(key);
-        // 检查 LFU 部分是否存在该键
-        bool inLfu = lfuPart_->contain(key);
-        // 更新 LRU 部分缓存
-        lruPart_->put(key, value);
-        // 如果 LFU 部分存在该键，则更新 LFU 部分
-        if (inLfu) {
+        // 如果 LFU 部分存在该键，则同时更新 LFU 部分
+        if (lfuPart_->contain(key)) {
             lfuPart_->put(key, value);
         }
+        lruPart_->put(key, std::forward<V>(value));
     }
 
-    bool get(Key key, Value& value) override {
+    // 键在两个部分中都不存在时用 args 构造 value 并插入，返回是否插入
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (lruPart_->contain(key) || lfuPart_->contain(key)) {
+            return false;
+        }
+        checkGhostCaches(key);
+        return lruPart_->put(key, Value(std::forward<Args>(args)...));
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
         checkGhostCaches(key);
         bool shouldTransform = false;
+        bool hit = false;
         if (lruPart_->get(key, value, shouldTransform)) {
             if (shouldTransform) {
-                lfuPart_->put(key, value);
+                lfuPart_->put(Key(key), value);
             }
-            return true;
+            hit = true;
+        } else {
+            hit = lfuPart_->get(key, value);
+        }
+        stats_.record(hit ? StatCounter::Hits : StatCounter::Misses);
+        return hit;
+    }
+
+    // 读取 value，不检查幽灵缓存、不更新访问记录，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        return lruPart_->peek(key, value) || lfuPart_->peek(key, value);
+    }
+
+    // 统计快照，size 为两个部分的条目数之和（同一个键可能同时存在于两部分）
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = lruPart_->size() + lfuPart_->size();
+        result.weight = lruPart_->weight() + lfuPart_->weight();
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 在线调整容量（条目数或字节预算，与构造方式一致）。两个部分按当前的
+    // 容量比例缩放，已学到的偏向不变；总和与构造时一样，按字节预算时为
+    // capacity，按条目数时为 2 * capacity。超额条目的淘汰见
+    // kResizeEvictionStep。按条目数时幽灵链表的大小保持不变
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t newTotal = weighted_ ? capacity : 2 * capacity;
+        size_t lruCapacity = lruPart_->capacity();
+        size_t total = lruCapacity + lfuPart_->capacity();
+        size_t newLruCapacity = newTotal / 2;
+        if (total > 0) {
+            newLruCapacity = static_cast<size_t>(
+                static_cast<double>(lruCapacity) / total * newTotal);
         }
-        return lfuPart_->get(key, value);
+        lruPart_->setCapacity(newLruCapacity);
+        lfuPart_->setCapacity(newTotal - newLruCapacity);
+        capacity_ = capacity;
     }
 
-    Value get(Key key) override {
-        Value value{};
-        get(key, value);
-        return value;
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
     }
 
    private:
-    bool checkGhostCaches(Key key) {
+    // 缩容后两个部分各自分批淘汰超额条目
+    void shrinkStep() {
+        lruPart_->shrinkStep();
+        lfuPart_->shrinkStep();
+    }
+
+    template <typename K>
+    bool checkGhostCaches(const K& key) {
         bool inGhost = false;
         if (lruPart_->checkGhost(key)) {
-            if (lfuPart_->decreaseCapacity()) {
-                lruPart_->increaseCapacity();
-            }
+            lruPart_->increaseCapacity(lfuPart_->decreaseCapacity());
             inGhost = true;
         } else if (lfuPart_->checkGhost(key)) {
-            if (lruPart_->decreaseCapacity()) {
-                lfuPart_->increaseCapacity();
-            }
+            lfuPart_->increaseCapacity(lruPart_->decreaseCapacity());
             inGhost = true;
         }
+        if (inGhost) {
+            stats_.record(StatCounter::GhostHits);
+        }
         return inGhost;
     }
 
    private:
+    // 容量：按条目数时两个部分的容量之和为其两倍，按字节预算时两部分平分
     size_t capacity_;
     size_t transformThreshold_;
+    bool weighted_;  // 是否按字节预算
+    // 幽灵检查、容量调整和两个部分的读写共用这一把锁，每次操作只加锁一次
+    std::mutex mutex_;
+    StatsRecorder stats_;  // 两个部分共用的统计计数，需先于两部分构造
     std::unique_ptr<ArcLruPart<Key, Value>> lruPart_;
     std::unique_ptr<ArcLfuPart<Key, Value>> lfuPart_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 namespace IncreCache {
 template <typename Key, typename Value>
@@ -9,20 +10,29 @@ class ArcNode {
     Key key_;
     Value value_;
     size_t accessCount_;
+    size_t weight_;  // 计入容量的权重
     std::weak_ptr<ArcNode> prev_;
     std::shared_ptr<ArcNode> next_;
 
    public:
-    ArcNode() : accessCount_(1), next_(nullptr) {}
-    ArcNode(Key key, Value value)
-        : key_(key), value_(value), accessCount_(1), next_(nullptr) {}
+    ArcNode() : accessCount_(1), weight_(0), next_(nullptr) {}
+    template <typename V>
+    ArcNode(const Key& key, V&& value)
+        : key_(key),
+          value_(std::forward<V>(value)),
+          accessCount_(1),
+          weight_(0),
+          next_(nullptr) {}
 
     // Getters
     Key getKey() const { return key_; }
     Value getValue() const { return value_; }
     size_t getAccessCount() const { return accessCount_; }
     // Setters
-    void setValue(const Value& value) { value_ = value; }
+    template <typename V>
+    void setValue(V&& value) {
+        value_ = std::forward<V>(value);
+    }
     void incrementAccessCount() { ++accessCount_; }
 
     template <typename K, typename V>
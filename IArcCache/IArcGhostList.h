@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../ICacheKey.h"
+#include "../ICachePolicy.h"
+#include "../IHashMix.h"
+
+namespace IncreCache {
+// 幽灵链表：只记录被淘汰键的 64 位指纹，不保留结点和值
+// 指纹按淘汰顺序写入环形数组（FIFO），另用哈希表记录指纹所在的序号；
+// 命中时只从哈希表删除，环形数组中留下的失效槽位在出队或压缩时跳过。
+// 环形数组和哈希表都随记录的指纹数按需增长，不按容量预先分配
+template <typename Key>
+class ArcGhostList {
+   public:
+    explicit ArcGhostList(size_t capacity)
+        : capacity_(capacity), head_(0), tail_(0) {}
+
+    // 记录一个被淘汰的键，已满时丢弃最早进入的指纹
+    void push(const Key& key) {
+        if (capacity_ == 0) {
+            return;
+        }
+        uint64_t fingerprint = fingerprintOf(key);
+        index_.erase(fingerprint);
+        // 缩容后超出容量的指纹每次写入多丢弃一个，逐步回到容量以内
+        for (int n = 0; n < 2 && index_.size() >= capacity_; ++n) {
+            popOldest();
+        }
+        if (tail_ - head_ == ring_.size()) {
+            // 环形数组最多留出与容量相同的余量容纳失效槽位，未到上限时翻倍
+            compact(std::min(std::max<size_t>(ring_.size() * 2, kMinRingSize),
+                             maxRingSize()));
+        }
+        ring_[tail_ % ring_.size()] = fingerprint;
+        index_[fingerprint] = tail_++;
+    }
+
+    // 若键在幽灵链表中则移除并返回 true
+    template <typename K>
+    bool take(const K& key) {
+        return index_.erase(fingerprintOf(key)) > 0;
+    }
+
+    template <typename K>
+    bool contains(const K& key) const {
+        return index_.find(fingerprintOf(key)) != index_.end();
+    }
+
+    // 移除最早进入且仍然有效的指纹
+    void popOldest() {
+        while (head_ != tail_) {
+            if (popFront()) {
+                return;
+            }
+        }
+    }
+
+    // 调整最多记录的指纹数量，超出部分从最早进入的开始丢弃，每次至多丢弃
+    // kResizeEvictionStep 个，其余由之后的写入分批丢弃；回到容量以内且容量
+    // 降到环形数组的四分之一以下时压缩到新的上限，释放多余的槽位
+    void setCapacity(size_t capacity) {
+        capacity_ = capacity;
+        for (size_t n = 0; n < kResizeEvictionStep && index_.size() > capacity_;
+             ++n) {
+            popOldest();
+        }
+        if (index_.size() <= capacity_ && ring_.size() > kMinRingSize &&
+            ring_.size() / 4 > maxRingSize()) {
+            compact(maxRingSize());
+            ring_.shrink_to_fit();
+            scratch_.shrink_to_fit();
+        }
+    }
+
+    size_t size() const { return index_.size(); }
+
+    bool empty() const { return index_.empty(); }
+
+   private:
+    static constexpr size_t kMinRingSize = 16;
+
+    size_t maxRingSize() const {
+        return std::max<size_t>(capacity_ * 2, kMinRingSize);
+    }
+
+    template <typename K>
+    static uint64_t fingerprintOf(const K& key) {
+        return mixHash(CacheHash<Key>()(key));
+    }
+
+    // 弹出环形数组头部的槽位，槽位仍然有效时返回 true
+    bool popFront() {
+        uint64_t fingerprint = ring_[head_ % ring_.size()];
+        auto it = index_.find(fingerprint);
+        bool live = it != index_.end() && it->second == head_;
+        if (live) {
+            index_.erase(it);
+        }
+        ++head_;
+        return live;
+    }
+
+    // 把有效指纹依次前移到大小为 ringSize 的环形数组中。写满时压缩的槽位中
+    // 失效槽位至少占一半，或者数组刚翻倍，压缩摊还 O(1)
+    void compact(size_t ringSize) {
+        uint64_t next = 0;
+        for (uint64_t seq = head_; seq != tail_; ++seq) {
+            uint64_t fingerprint = ring_[seq % ring_.size()];
+            auto it = index_.find(fingerprint);
+            if (it != index_.end() && it->second == seq) {
+                scratch_.push_back(fingerprint);
+                it->second = next++;
+            }
+        }
+        ring_.resize(ringSize);
+        for (uint64_t seq = 0; seq < next; ++seq) {
+            ring_[seq] = scratch_[seq];
+        }
+        scratch_.clear();
+        head_ = 0;
+        tail_ = next;
+    }
+
+   private:
+    size_t capacity_;                // 最多记录的指纹数量
+    uint64_t head_;                  // 最早槽位的序号
+    uint64_t tail_;                  // 下一个写入槽位的序号
+    std::vector<uint64_t> ring_;     // 指纹环形数组，下标为序号取模
+    std::vector<uint64_t> scratch_;  // 压缩时使用的临时缓冲
+    IndexMap<uint64_t, uint64_t> index_;  // 指纹 -> 序号
+};
+}  // namespace IncreCache
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <map>
-#include <mutex>
 #include <unordered_map>
 
+#include "../ICacheKey.h"
+#include "../ICachePolicy.h"
+#include "../ICacheStats.h"
+#include "../ICacheWeigher.h"
 #include "IArcCacheNode.h"
+#include "IArcGhostList.h"
 
 namespace IncreCache {
 template <typename Key, typename Value>
@@ -12,31 +17,37 @@ class ArcLfuPart {
    public:
     using NodeType = ArcNode<Key, Value>;
     using NodePtr = std::shared_ptr<NodeType>;
-    using NodeMap = std::unordered_map<Key, NodePtr>;
+    using NodeMap = IndexMap<Key, NodePtr>;
     using FreqMap = std::map<size_t, std::list<NodePtr>>;
+    using Weigher = CacheWeigher<Key, Value>;
 
-    explicit ArcLfuPart(size_t capacity, size_t transformThreshold)
+    // 设置 weigher 时 capacity 为字节预算，幽灵链表最多记录与本部分现存条目
+    // 一样多的键；按条目数计时最多记录 capacity 个键
+    ArcLfuPart(size_t capacity, size_t transformThreshold,
+               StatsRecorder& stats, Weigher weigher = Weigher())
         : capacity_(capacity),
-          ghostCapacity_(capacity),
           transformThreshold_(transformThreshold),
-          minFreq_(0) {
-        initializeLists();
-    }
-
-    bool put(Key key, Value value) {
+          minFreq_(0),
+          ghostCache_(weigher ? 0 : capacity),
+          stats_(stats),
+          weigher_(std::move(weigher), entryOverhead()),
+          weight_(0) {}
+
+    // value 转发到结点中，IArcCache 传入的右值只移动不拷贝
+    template <typename V>
+    bool put(const Key& key, V&& value) {
         if (capacity_ == 0) {
             return false;
         }
-        std::lock_guard<std::mutex> lock(mutex_);
         auto it = mainCache_.find(key);
         if (it != mainCache_.end()) {
-            return updateExistingNode(it->second, value);
+            return updateExistingNode(it->second, std::forward<V>(value));
         }
-        return addNewNode(key, value);
+        return addNewNode(key, std::forward<V>(value));
     }
 
-    bool get(Key key, Value& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    template <typename K>
+    bool get(const K& key, Value& value) {
         auto it = mainCache_.find(key);
         if (it != mainCache_.end()) {
             updateNodeFrequency(it->second);
@@ -46,50 +57,101 @@ class ArcLfuPart {
         return false;
     }
 
-    bool contain(Key key) { return mainCache_.find(key) != mainCache_.end(); }
-
-    bool checkGhost(Key key) {
-        auto it = ghostCache_.find(key);
-        if (it != ghostCache_.end()) {
-            removeFromGhost(it->second);
-            ghostCache_.erase(it);
-            return true;
+    // 只读取 value，不更新访问记录
+    template <typename K>
+    bool peek(const K& key, Value& value) const {
+        auto it = mainCache_.find(key);
+        if (it == mainCache_.end()) {
+            return false;
         }
-        return false;
+        value = it->second->getValue();
+        return true;
+    }
+
+    template <typename K>
+    bool contain(const K& key) {
+        return mainCache_.find(key) != mainCache_.end();
     }
 
-    void increaseCapacity() { ++capacity_; }
+    template <typename K>
+    bool checkGhost(const K& key) { return ghostCache_.take(key); }
 
-    bool decreaseCapacity() {
-        if (capacity_ <= 0) {
-            return false;
+    void increaseCapacity(size_t step) { capacity_ += step; }
+
+    size_t size() const { return mainCache_.size(); }
+
+    size_t weight() const { return weight_; }
+
+    size_t capacity() const { return capacity_; }
+
+    // 调整容量，超额条目由 shrinkStep 分批淘汰
+    void setCapacity(size_t capacity) {
+        capacity_ = capacity;
+        shrinkStep();
+    }
+
+    // 缩容后淘汰至多 kResizeEvictionStep 个超额条目
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep && weight_ > capacity_;
+             ++n) {
+            evictLeastFrequent();
         }
-        if (mainCache_.size() == capacity_) {
+    }
+
+    // 让出一份容量，返回让出的量，0 表示已无容量可让。
+    // 按条目数计时每次让出 1，按字节预算时让出本部分条目的平均权重
+    size_t decreaseCapacity() {
+        size_t step = 1;
+        if (weigher_.weighted() && !mainCache_.empty()) {
+            step = weight_ / mainCache_.size();
+        }
+        step = std::min(step, capacity_);
+        // 缩容后超额条目尚未淘汰完时只淘汰让出的那一份
+        size_t limit = std::max(capacity_, weight_) - step;
+        capacity_ -= step;
+        while (weight_ > limit) {
             evictLeastFrequent();
         }
-        --capacity_;
-        return true;
+        return step;
     }
 
    private:
-    void initializeLists() {
-        ghostHead_ = std::make_shared<NodeType>();
-        ghostTail_ = std::make_shared<NodeType>();
-        ghostHead_->next_ = ghostTail_;
-        ghostTail_->prev_ = ghostHead_;
+    // 结点还挂在频次链表（std::list）上
+    static constexpr size_t entryOverhead() {
+        return sharedEntryBytes<Key, NodeType>() + listNodeBytes<NodePtr>();
     }
 
-    bool updateExistingNode(NodePtr node, const Value& value) {
-        node->setValue(value);
+    template <typename V>
+    bool updateExistingNode(NodePtr node, V&& value) {
+        size_t limit = std::max(capacity_, weight_);
+        node->setValue(std::forward<V>(value));
         updateNodeFrequency(node);
+        size_t weight = weigher_(node->key_, node->value_);
+        weight_ = weight_ - node->weight_ + weight;
+        node->weight_ = weight;
+        while (weight_ > limit) {
+            evictLeastFrequent();
+        }
         return true;
     }
 
-    bool addNewNode(const Key& key, const Value& value) {
-        if (mainCache_.size() >= capacity_) {
+    template <typename V>
+    bool addNewNode(const Key& key, V&& value) {
+        size_t weight = weigher_(key, value);
+        if (weight > capacity_) {
+            // 单个条目超出本部分的全部容量，不缓存
+            stats_.record(StatCounter::Rejections);
+            return false;
+        }
+        // 缩容后超额条目尚未淘汰完时，只保证本次写入不增加超额部分
+        size_t limit = std::max(capacity_, weight_);
+        while (weight_ + weight > limit) {
             evictLeastFrequent();
         }
-        NodePtr newNode = std::make_shared<NodeType>(key, value);
+        NodePtr newNode =
+            std::make_shared<NodeType>(key, std::forward<V>(value));
+        newNode->weight_ = weight;
+        weight_ += weight;
         mainCache_[key] = newNode;
         // 将新节点添加到频率为 1 的列表中
         if (freqMap_.find(1) == freqMap_.end()) {
@@ -141,54 +203,29 @@ class ArcLfuPart {
                 minFreq_ = freqMap_.begin()->first;
             }
         }
-        // 将节点移到幽灵缓存
-        if (ghostCache_.size() >= ghostCapacity_) {
-            removeOldestGhost();
+        weight_ -= leastNode->weight_;
+        // 按字节预算时幽灵链表的容量跟随现存条目数，其内存与条目数成正比，
+        // 远小于这些条目计入预算的权重
+        if (weigher_.weighted()) {
+            ghostCache_.setCapacity(mainCache_.size());
         }
-        addToGhost(leastNode);
+        // 只把键的指纹记入幽灵缓存（满时自动丢弃最早的），结点和值随即释放
+        ghostCache_.push(leastNode->getKey());
         // 从主缓存中移除
         mainCache_.erase(leastNode->getKey());
-    }
-
-    void removeFromGhost(NodePtr node) {
-        if (!node->prev_.expired() && node->next_) {
-            auto prev = node->prev_.lock();
-            prev->next_ = node->next_;
-            node->next_->prev_ = node->prev_;
-            node->next_ = nullptr;  // 清空指针，防止悬垂引用
-        }
-    }
-
-    void addToGhost(NodePtr node) {
-        node->next_ = ghostTail_;
-        node->prev_ = ghostTail_->prev_;
-        if (!ghostTail_->prev_.expired()) {
-            ghostTail_->prev_.lock()->next_ = node;
-        }
-        ghostTail_->prev_ = node;
-        ghostCache_[node->getKey()] = node;
-    }
-
-    void removeOldestGhost() {
-        NodePtr oldestGhost = ghostHead_->next_;
-        if (oldestGhost != ghostTail_) {
-            removeFromGhost(oldestGhost);
-            ghostCache_.erase(oldestGhost->getKey());
-        }
+        stats_.record(StatCounter::Evictions);
     }
 
    private:
     size_t capacity_;
-    size_t ghostCapacity_;
     size_t transformThreshold_;
     size_t minFreq_;
-    std::mutex mutex_;
 
     NodeMap mainCache_;
-    NodeMap ghostCache_;
+    ArcGhostList<Key> ghostCache_;  // 淘汰键的指纹
+    StatsRecorder& stats_;          // 所属 IArcCache 的统计计数
     FreqMap freqMap_;
-
-    NodePtr ghostHead_;
-    NodePtr ghostTail_;
+    EntryWeigher<Key, Value> weigher_;  // 条目权重，默认每个条目计 1
+    size_t weight_;                     // 当前总权重
 };
 }  // namespace IncreCache
\ No newline at end of file
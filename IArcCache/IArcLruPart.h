@@ -1,9 +1,14 @@
 #pragma once
 
-#include <mutex>
+#include <algorithm>
 #include <unordered_map>
 
+#include "../ICacheKey.h"
+#include "../ICachePolicy.h"
+#include "../ICacheStats.h"
+#include "../ICacheWeigher.h"
 #include "IArcCacheNode.h"
+#include "IArcGhostList.h"
 
 namespace IncreCache {
 template <typename Key, typename Value>
@@ -11,29 +16,40 @@ class ArcLruPart {
    public:
     using NodeType = ArcNode<Key, Value>;
     using NodePtr = std::shared_ptr<NodeType>;
-    using NodeMap = std::unordered_map<Key, NodePtr>;
+    using NodeMap = IndexMap<Key, NodePtr>;
+    using Weigher = CacheWeigher<Key, Value>;
 
-    explicit ArcLruPart(size_t capacity, size_t transformThreshold)
+    // 设置 weigher 时 capacity 为字节预算，幽灵链表最多记录与本部分现存条目
+    // 一样多的键；按条目数计时最多记录 capacity 个键
+    ArcLruPart(size_t capacity, size_t transformThreshold,
+               StatsRecorder& stats, Weigher weigher = Weigher())
         : capacity_(capacity),
-          ghostCapacity_(capacity),
-          transformThreshold_(transformThreshold) {
+          transformThreshold_(transformThreshold),
+          ghostCache_(weigher ? 0 : capacity),
+          stats_(stats),
+          weigher_(std::move(weigher), entryOverhead()),
+          weight_(0) {
         initializeLists();
     }
 
-    bool put(Key key, Value value) {
+    // 右值 value 一路移动到结点中，不产生额外拷贝
+    template <typename V>
+    bool put(const Key& key, V&& value) {
         if (capacity_ == 0) {
             return false;
         }
-        std::lock_guard<std::mutex> lock(mutex_);
         auto it = mainCache_.find(key);
+        // 用户的写入都经过 LRU 部分，在这里统计插入与更新
         if (it != mainCache_.end()) {
-            return updateExistingNode(it->second, value);
+            stats_.record(StatCounter::Updates);
+            return updateExistingNode(it->second, std::forward<V>(value));
         }
-        return addNewNode(key, value);
+        stats_.record(StatCounter::Puts);
+        return addNewNode(key, std::forward<V>(value));
     }
 
-    bool get(Key key, Value& value, bool& shouldTransform) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    template <typename K>
+    bool get(const K& key, Value& value, bool& shouldTransform) {
         auto it = mainCache_.find(key);
         if (it != mainCache_.end()) {
             shouldTransform = updateNodeAccess(it->second);
@@ -43,53 +59,108 @@ class ArcLruPart {
         return false;
     }
 
-    bool checkGhost(Key key) {
-        auto it = ghostCache_.find(key);
-        if (it != ghostCache_.end()) {
-            removeFromGhost(it->second);
-            ghostCache_.erase(it);
-            return true;
+    // 只读取 value，不更新访问记录
+    template <typename K>
+    bool peek(const K& key, Value& value) const {
+        auto it = mainCache_.find(key);
+        if (it == mainCache_.end()) {
+            return false;
         }
-        return false;
+        value = it->second->getValue();
+        return true;
     }
 
-    void increaseCapacity() { ++capacity_; }
+    template <typename K>
+    bool contain(const K& key) {
+        return mainCache_.find(key) != mainCache_.end();
+    }
 
-    bool decreaseCapacity() {
-        if (capacity_ <= 0) {
-            return false;
+    template <typename K>
+    bool checkGhost(const K& key) { return ghostCache_.take(key); }
+
+    void increaseCapacity(size_t step) { capacity_ += step; }
+
+    size_t size() const { return mainCache_.size(); }
+
+    size_t weight() const { return weight_; }
+
+    size_t capacity() const { return capacity_; }
+
+    // 调整容量，超额条目由 shrinkStep 分批淘汰
+    void setCapacity(size_t capacity) {
+        capacity_ = capacity;
+        shrinkStep();
+    }
+
+    // 缩容后淘汰至多 kResizeEvictionStep 个超额条目
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep && weight_ > capacity_;
+             ++n) {
+            evictLeastRecent();
         }
-        if (mainCache_.size() == capacity_) {
+    }
+
+    // 让出一份容量，返回让出的量，0 表示已无容量可让。
+    // 按条目数计时每次让出 1，按字节预算时让出本部分条目的平均权重
+    size_t decreaseCapacity() {
+        size_t step = 1;
+        if (weigher_.weighted() && !mainCache_.empty()) {
+            step = weight_ / mainCache_.size();
+        }
+        step = std::min(step, capacity_);
+        // 缩容后超额条目尚未淘汰完时只淘汰让出的那一份
+        size_t limit = std::max(capacity_, weight_) - step;
+        capacity_ -= step;
+        while (weight_ > limit) {
             evictLeastRecent();
         }
-        --capacity_;
-        return true;
+        return step;
     }
 
    private:
+    static constexpr size_t entryOverhead() {
+        return sharedEntryBytes<Key, NodeType>();
+    }
+
     void initializeLists() {
         mainHead_ = std::make_shared<NodeType>();
         mainTail_ = std::make_shared<NodeType>();
         mainHead_->next_ = mainTail_;
         mainTail_->prev_ = mainHead_;
-
-        ghostHead_ = std::make_shared<NodeType>();
-        ghostTail_ = std::make_shared<NodeType>();
-        ghostHead_->next_ = ghostTail_;
-        ghostTail_->prev_ = ghostHead_;
     }
 
-    bool updateExistingNode(NodePtr node, const Value& value) {
-        node->setValue(value);
+    // 权重变大时从最近最少访问端淘汰，该结点已在最近端，最后才会被淘汰
+    template <typename V>
+    bool updateExistingNode(NodePtr node, V&& value) {
+        size_t limit = std::max(capacity_, weight_);
+        node->setValue(std::forward<V>(value));
         moveToFront(node);
+        size_t weight = weigher_(node->key_, node->value_);
+        weight_ = weight_ - node->weight_ + weight;
+        node->weight_ = weight;
+        while (weight_ > limit) {
+            evictLeastRecent();
+        }
         return true;
     }
 
-    bool addNewNode(const Key& key, const Value& value) {
-        if (mainCache_.size() >= capacity_) {
+    template <typename V>
+    bool addNewNode(const Key& key, V&& value) {
+        size_t weight = weigher_(key, value);
+        if (weight > capacity_) {
+            // 单个条目超出本部分的全部容量，不缓存
+            stats_.record(StatCounter::Rejections);
+            return false;
+        }
+        // 缩容后超额条目尚未淘汰完时，只保证本次写入不增加超额部分
+        size_t limit = std::max(capacity_, weight_);
+        while (weight_ + weight > limit) {
             evictLeastRecent();  // 驱逐最近最少访问
         }
-        NodePtr newNode = std::make_shared<NodeType>(key, value);
+        NodePtr newNode =
+            std::make_shared<NodeType>(key, std::forward<V>(value));
+        newNode->weight_ = weight;
+        weight_ += weight;
         mainCache_[key] = newNode;
         addToFront(newNode);
         return true;
@@ -127,13 +198,17 @@ class ArcLruPart {
         }
         // 从主链表中移除
         removeFromMain(leastRecent);
-        // 添加到幽灵缓存
-        if (ghostCache_.size() >= ghostCapacity_) {
-            removeOldestGhost();
+        weight_ -= leastRecent->weight_;
+        // 按字节预算时幽灵链表的容量跟随现存条目数，其内存与条目数成正比，
+        // 远小于这些条目计入预算的权重
+        if (weigher_.weighted()) {
+            ghostCache_.setCapacity(mainCache_.size());
         }
-        addToGhost(leastRecent);
+        // 只把键的指纹记入幽灵缓存（满时自动丢弃最早的），结点和值随即释放
+        ghostCache_.push(leastRecent->getKey());
         // 从主缓存映射中移除
         mainCache_.erase(leastRecent->getKey());
+        stats_.record(StatCounter::Evictions);
     }
 
     void removeFromMain(NodePtr node) {
@@ -145,51 +220,18 @@ class ArcLruPart {
         }
     }
 
-    void removeFromGhost(NodePtr node) {
-        if (!node->prev_.expired() && node->next_) {
-            auto prev = node->prev_.lock();
-            prev->next_ = node->next_;
-            node->next_->prev_ = node->prev_;
-            node->next_ = nullptr;  // 清空指针，防止悬垂引用
-        }
-    }
-
-    void addToGhost(NodePtr node) {
-        // 重置节点的访问计数
-        node->accessCount_ = 1;
-        // 添加到幽灵缓存的头部
-        node->next_ = ghostHead_->next_;
-        node->prev_ = ghostHead_;
-        ghostHead_->next_->prev_ = node;
-        ghostHead_->next_ = node;
-        // 添加到幽灵缓存映射
-        ghostCache_[node->getKey()] = node;
-    }
-
-    void removeOldestGhost() {
-        // 使用 lock() 方法，并添加 null 检查
-        NodePtr oldestGhost = ghostTail_->prev_.lock();
-        if (!oldestGhost || oldestGhost == ghostHead_) {
-            return;
-        }
-        removeFromGhost(oldestGhost);
-        ghostCache_.erase(oldestGhost->getKey());
-    }
-
    private:
     size_t capacity_;
-    size_t ghostCapacity_;
     size_t transformThreshold_;  // 转换门槛值
-    std::mutex mutex_;
 
     NodeMap mainCache_;  // key - > ArcNode
-    NodeMap ghostCache_;
+    ArcGhostList<Key> ghostCache_;  // 淘汰键的指纹
+    StatsRecorder& stats_;          // 所属 IArcCache 的统计计数
+    EntryWeigher<Key, Value> weigher_;  // 条目权重，默认每个条目计 1
+    size_t weight_;                     // 当前总权重
 
     // 主链表
     NodePtr mainHead_;
     NodePtr mainTail_;
-    // 淘汰链表
-    NodePtr ghostHead_;
-    NodePtr ghostTail_;
 };
 }  // namespace IncreCache
\ No newline at end of file
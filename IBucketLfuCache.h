@@ -0,0 +1,388 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ICacheKey.h"
+#include "ICachePolicy.h"
+#include "ICacheStats.h"
+#include "ISegmentedArray.h"
+
+namespace IncreCache {
+template <typename Key, typename Value>
+class IBucketLfuCache;
+
+template <typename Key, typename Value>
+class BucketLfuNode {
+   private:
+    Key key_;
+    Value value_;
+    uint32_t bucket_;    // 所在频次桶的下标
+    uint32_t prev_;      // 桶内链表前驱下标
+    uint32_t next_;      // 桶内链表后继下标（空闲时作为空闲链表的指针）
+    uint32_t hashNext_;  // 同一哈希桶内下一个结点的下标
+
+   public:
+    BucketLfuNode()
+        : key_(), value_(), bucket_(0), prev_(0), next_(0), hashNext_(0) {}
+
+    Key getKey() const { return key_; }
+
+    Value getValue() const { return value_; }
+
+    friend class IBucketLfuCache<Key, Value>;
+};
+
+// 频次桶：按频次升序串成双向链表，相邻桶的频次通常只差 1
+struct LfuFreqBucket {
+    uint64_t freq;  // 桶内结点的访问频次
+    uint32_t prev;  // 频次更低的相邻桶（空闲时作为空闲链表的指针）
+    uint32_t next;  // 频次更高的相邻桶
+    uint32_t head;  // 桶内最早进入的结点，淘汰时从这里取
+    uint32_t tail;  // 桶内最新进入的结点
+
+    LfuFreqBucket() : freq(0), prev(0), next(0), head(0), tail(0) {}
+};
+
+// LFU 优化，频次桶组成有序链表，结点与频次桶都从预分配的池中取用
+// 访问时结点只会移动到相邻的 freq + 1 桶，get/put 均为真正的 O(1)，
+// 空桶立即回收，内存占用只与容量相关。扩容时两个池追加新段，已有结点不移动
+template <typename Key, typename Value>
+class IBucketLfuCache
+    : public ICachePolicyAdapter<IBucketLfuCache<Key, Value>, Key, Value> {
+   public:
+    using NodeType = BucketLfuNode<Key, Value>;
+
+    explicit IBucketLfuCache(int capacity)
+        : capacity_(capacity > 0 ? capacity : 0),
+          size_(0),
+          freeNodeHead_(kNil),
+          freeBucketHead_(kNil),
+          nodes_(capacity_ + 1),
+          buckets_(capacity_ + 2) {
+        initializePools();
+    }
+
+    ~IBucketLfuCache() override = default;
+
+    // 插入或更新，右值 value 直接移动到结点中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return;
+        }
+        uint32_t index = findNode(key);
+        if (index != kNil) {
+            // 已存在则更新 value，并视为一次访问
+            nodes_[index].value_ = std::forward<V>(value);
+            increaseFreq(index);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        addNewNode(key, std::forward<V>(value));
+        stats_.record(StatCounter::Puts);
+    }
+
+    // 键不存在时用 args 构造 value 并插入，返回是否插入；键已存在时不做任何修改
+    // 结点池中的 value 是预先构造好的，这里构造临时对象后移动赋值进去
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return false;
+        }
+        if (findNode(key) != kNil) {
+            return false;
+        }
+        addNewNode(key, Value(std::forward<Args>(args)...));
+        stats_.record(StatCounter::Puts);
+        return true;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        uint32_t index = findNode(key);
+        if (index == kNil) {
+            stats_.record(StatCounter::Misses);
+            return false;
+        }
+        increaseFreq(index);
+        value = nodes_[index].value_;
+        stats_.record(StatCounter::Hits);
+        return true;
+    }
+
+    // 读取 value，不增加访问频次，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        uint32_t index = findNode(key);
+        if (index == kNil) {
+            return false;
+        }
+        value = nodes_[index].value_;
+        return true;
+    }
+
+    // 删除指定元素
+    template <typename K>
+    void remove(const K& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t index = findNode(key);
+        if (index != kNil) {
+            nodes_[index].value_ = Value();
+            eraseNode(index);
+        }
+    }
+
+    // 清空缓存，结点池和频次桶池按当前容量重新分配
+    void purge() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nodes_ = SegmentedArray<NodeType>(capacity_ + 1);
+        buckets_ = SegmentedArray<LfuFreqBucket>(capacity_ + 2);
+        size_ = 0;
+        freeNodeHead_ = kNil;
+        freeBucketHead_ = kNil;
+        initializePools();
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = size_;
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 在线调整容量（见 kResizeEvictionStep）。扩容时两个池追加新段，新结点和
+    // 新桶加入各自的空闲链表，已有结点不移动，哈希桶随写入按需翻倍
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t oldNodes = nodes_.size();
+        nodes_.grow(capacity + 1);
+        for (size_t i = nodes_.size() - 1; i >= oldNodes; --i) {
+            nodes_[i].next_ = freeNodeHead_;
+            freeNodeHead_ = static_cast<uint32_t>(i);
+        }
+        size_t oldBuckets = buckets_.size();
+        buckets_.grow(capacity + 2);
+        for (size_t i = buckets_.size() - 1; i >= oldBuckets; --i) {
+            buckets_[i].prev = freeBucketHead_;
+            freeBucketHead_ = static_cast<uint32_t>(i);
+        }
+        capacity_ = capacity;
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+   private:
+    // 下标 0 在结点池和桶池中都作为哨兵/空值
+    static constexpr uint32_t kNil = 0;
+
+    void initializePools() {
+        size_t capacity = capacity_;
+        for (uint32_t i = static_cast<uint32_t>(capacity); i > 0; --i) {
+            nodes_[i].next_ = freeNodeHead_;
+            freeNodeHead_ = i;
+        }
+        // 非空桶数量不超过结点数量，迁移结点时可能临时多出一个桶
+        buckets_[kNil].prev = kNil;
+        buckets_[kNil].next = kNil;
+        for (uint32_t i = static_cast<uint32_t>(capacity + 1); i > 0; --i) {
+            buckets_[i].prev = freeBucketHead_;
+            freeBucketHead_ = i;
+        }
+        size_t bucketCount = 1;
+        while (bucketCount < capacity) {
+            bucketCount <<= 1;
+        }
+        hashBuckets_.assign(bucketCount, kNil);
+        hashMask_ = bucketCount - 1;
+    }
+
+    // 扩容后结点数超过哈希桶数时桶数翻倍，沿频次桶链表重新串起所有结点
+    void growHashBuckets() {
+        hashBuckets_.assign(hashBuckets_.size() * 2, kNil);
+        hashMask_ = hashBuckets_.size() - 1;
+        for (uint32_t bucket = buckets_[kNil].next; bucket != kNil;
+             bucket = buckets_[bucket].next) {
+            for (uint32_t index = buckets_[bucket].head; index != kNil;
+                 index = nodes_[index].next_) {
+                size_t hash = hashOf(nodes_[index].key_);
+                nodes_[index].hashNext_ = hashBuckets_[hash];
+                hashBuckets_[hash] = index;
+            }
+        }
+    }
+
+    // 缩容后淘汰至多 kResizeEvictionStep 个超额条目
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep && size_ > capacity_; ++n) {
+            evictLeastFrequent();
+        }
+    }
+
+    template <typename K>
+    size_t hashOf(const K& key) const {
+        return CacheHash<Key>()(key) & hashMask_;
+    }
+
+    template <typename K>
+    uint32_t findNode(const K& key) const {
+        uint32_t index = hashBuckets_[hashOf(key)];
+        while (index != kNil && !(nodes_[index].key_ == key)) {
+            index = nodes_[index].hashNext_;
+        }
+        return index;
+    }
+
+    template <typename V>
+    void addNewNode(const Key& key, V&& value) {
+        // 缩容后超额条目尚未淘汰完时，淘汰一个再插入，不增加超额部分
+        if (size_ >= capacity_) {
+            evictLeastFrequent();
+        } else if (size_ >= hashBuckets_.size()) {
+            growHashBuckets();
+        }
+        uint32_t index = freeNodeHead_;
+        freeNodeHead_ = nodes_[index].next_;
+        NodeType& node = nodes_[index];
+        node.key_ = key;
+        node.value_ = std::forward<V>(value);
+        size_t hash = hashOf(key);
+        node.hashNext_ = hashBuckets_[hash];
+        hashBuckets_[hash] = index;
+        // 新结点进入频次为 1 的桶，该桶一定位于链表最前端
+        uint32_t first = buckets_[kNil].next;
+        if (first == kNil || buckets_[first].freq != 1) {
+            first = insertBucketAfter(kNil, 1);
+        }
+        appendToBucket(first, index);
+        ++size_;
+    }
+
+    // 结点频次 +1：从当前桶移动到相邻的 freq + 1 桶
+    void increaseFreq(uint32_t index) {
+        uint32_t bucket = nodes_[index].bucket_;
+        uint64_t nextFreq = buckets_[bucket].freq + 1;
+        uint32_t next = buckets_[bucket].next;
+        if (next == kNil || buckets_[next].freq != nextFreq) {
+            next = insertBucketAfter(bucket, nextFreq);
+        }
+        unlinkFromBucket(index);
+        appendToBucket(next, index);
+    }
+
+    // 淘汰最小频次桶中最早进入的结点
+    void evictLeastFrequent() {
+        uint32_t bucket = buckets_[kNil].next;
+        if (bucket == kNil) {
+            return;
+        }
+        uint32_t index = buckets_[bucket].head;
+        // 与 remove 一致，立即释放被淘汰 value 持有的资源
+        nodes_[index].value_ = Value();
+        eraseNode(index);
+        stats_.record(StatCounter::Evictions);
+    }
+
+    void eraseNode(uint32_t index) {
+        unlinkFromBucket(index);
+        uint32_t* link = &hashBuckets_[hashOf(nodes_[index].key_)];
+        while (*link != index) {
+            link = &nodes_[*link].hashNext_;
+        }
+        *link = nodes_[index].hashNext_;
+        nodes_[index].hashNext_ = kNil;
+        nodes_[index].next_ = freeNodeHead_;
+        freeNodeHead_ = index;
+        --size_;
+    }
+
+    void appendToBucket(uint32_t bucket, uint32_t index) {
+        NodeType& node = nodes_[index];
+        LfuFreqBucket& freqBucket = buckets_[bucket];
+        node.bucket_ = bucket;
+        node.prev_ = freqBucket.tail;
+        node.next_ = kNil;
+        if (freqBucket.tail != kNil) {
+            nodes_[freqBucket.tail].next_ = index;
+        } else {
+            freqBucket.head = index;
+        }
+        freqBucket.tail = index;
+    }
+
+    // 将结点移出所在的桶，桶空了则立即回收
+    void unlinkFromBucket(uint32_t index) {
+        NodeType& node = nodes_[index];
+        uint32_t bucket = node.bucket_;
+        LfuFreqBucket& freqBucket = buckets_[bucket];
+        if (node.prev_ != kNil) {
+            nodes_[node.prev_].next_ = node.next_;
+        } else {
+            freqBucket.head = node.next_;
+        }
+        if (node.next_ != kNil) {
+            nodes_[node.next_].prev_ = node.prev_;
+        } else {
+            freqBucket.tail = node.prev_;
+        }
+        node.prev_ = kNil;
+        node.next_ = kNil;
+        if (freqBucket.head == kNil) {
+            releaseBucket(bucket);
+        }
+    }
+
+    uint32_t insertBucketAfter(uint32_t prev, uint64_t freq) {
+        uint32_t bucket = freeBucketHead_;
+        freeBucketHead_ = buckets_[bucket].prev;
+        LfuFreqBucket& freqBucket = buckets_[bucket];
+        freqBucket.freq = freq;
+        freqBucket.head = kNil;
+        freqBucket.tail = kNil;
+        freqBucket.prev = prev;
+        freqBucket.next = buckets_[prev].next;
+        buckets_[freqBucket.next].prev = bucket;
+        buckets_[prev].next = bucket;
+        return bucket;
+    }
+
+    void releaseBucket(uint32_t bucket) {
+        LfuFreqBucket& freqBucket = buckets_[bucket];
+        buckets_[freqBucket.prev].next = freqBucket.next;
+        buckets_[freqBucket.next].prev = freqBucket.prev;
+        freqBucket.next = kNil;
+        freqBucket.prev = freeBucketHead_;
+        freeBucketHead_ = bucket;
+    }
+
+   private:
+    size_t capacity_;                    // 缓存容量
+    size_t size_;                        // 当前结点数量
+    uint32_t freeNodeHead_;              // 空闲结点链表头
+    uint32_t freeBucketHead_;            // 空闲频次桶链表头
+    size_t hashMask_;                    // 哈希桶下标掩码
+    SegmentedArray<NodeType> nodes_;     // 结点池，下标 0 为空值
+    SegmentedArray<LfuFreqBucket> buckets_;  // 频次桶池，下标 0 为哨兵
+    std::vector<uint32_t> hashBuckets_;  // 哈希桶，存放链头结点下标
+    std::mutex mutex_;
+    StatsRecorder stats_;                // 命中、淘汰等统计计数
+};
+}  // namespace IncreCache
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "ICacheKey.h"
+#include "ICachePolicy.h"
+#include "ICacheStats.h"
+
+namespace IncreCache {
+template <typename Key, typename Value>
+class IBufferedLruCache;
+
+template <typename Key, typename Value>
+class BufferedLruNode {
+   private:
+    Key key_;
+    Value value_;
+    BufferedLruNode* prev_;
+    BufferedLruNode* next_;
+
+   public:
+    BufferedLruNode() : key_(), value_(), prev_(nullptr), next_(nullptr) {}
+    // value 由参数原地构造
+    template <typename... Args>
+    BufferedLruNode(const Key& key, Args&&... args)
+        : key_(key),
+          value_(std::forward<Args>(args)...),
+          prev_(nullptr),
+          next_(nullptr) {}
+
+    Key getKey() const { return key_; }
+
+    Value getValue() const { return value_; }
+
+    friend class IBufferedLruCache<Key, Value>;
+};
+
+// LRU 优化，读多写少场景下的缓冲提升版本（参考 Caffeine 的读缓冲）
+// get 只持有共享锁查找并复制 value，把命中的结点记录到按线程分条的有损环形缓冲中，
+// 缓冲积累到一定数量后由某个线程尝试获取独占锁批量调整链表，命中不再串行于链表操作；
+// 缓冲已满时直接丢弃本次记录，因此淘汰顺序是近似 LRU
+template <typename Key, typename Value>
+class IBufferedLruCache
+    : public ICachePolicyAdapter<IBufferedLruCache<Key, Value>, Key, Value> {
+   public:
+    using NodeType = BufferedLruNode<Key, Value>;
+    using NodeMap = IndexMap<Key, std::unique_ptr<NodeType>>;
+
+    explicit IBufferedLruCache(int capacity)
+        : capacity_(capacity > 0 ? capacity : 0),
+          readBuffers_(new ReadBuffer[kStripeCount]) {
+        dummy_.prev_ = &dummy_;
+        dummy_.next_ = &dummy_;
+    }
+
+    ~IBufferedLruCache() override = default;
+
+    // 插入或更新，右值 value 直接移动到结点中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        // 写操作可能释放结点，先清空读缓冲，保证缓冲中不会残留悬空指针
+        drainReadBuffers();
+        shrinkStep();
+        // 容量可能被 setCapacity 调整，需持锁读取
+        if (capacity_ == 0) {
+            return;
+        }
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            it->second->value_ = std::forward<V>(value);
+            moveToMostRecent(it->second.get());
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        addNewNode(key, std::forward<V>(value));
+        stats_.record(StatCounter::Puts);
+    }
+
+    // 键不存在时用 args 在结点中原地构造 value，返回是否插入；
+    // 键已存在时不做任何修改
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        drainReadBuffers();
+        shrinkStep();
+        if (capacity_ == 0) {
+            return false;
+        }
+        if (nodeMap_.find(key) != nodeMap_.end()) {
+            return false;
+        }
+        addNewNode(key, std::forward<Args>(args)...);
+        stats_.record(StatCounter::Puts);
+        return true;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        bool shouldDrain = false;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = nodeMap_.find(key);
+            if (it == nodeMap_.end()) {
+                stats_.record(StatCounter::Misses);
+                return false;
+            }
+            value = it->second->value_;
+            shouldDrain = recordRead(it->second.get());
+        }
+        stats_.record(StatCounter::Hits);
+        if (shouldDrain) {
+            tryDrainReadBuffers();
+        }
+        return true;
+    }
+
+    // 读取 value，不写入读缓冲，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            return false;
+        }
+        value = it->second->value_;
+        return true;
+    }
+
+    // 删除指定元素
+    template <typename K>
+    void remove(const K& key) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        drainReadBuffers();
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            removeNode(it->second.get());
+            nodeMap_.erase(it);
+        }
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        result.size = nodeMap_.size();
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 在线调整容量（见 kResizeEvictionStep）。读操作只持共享锁，超额条目只由
+    // 写入分批淘汰
+    void setCapacity(size_t capacity) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        drainReadBuffers();
+        capacity_ = capacity;
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return capacity_;
+    }
+
+   private:
+    static constexpr size_t kStripeCount = 16;  // 读缓冲条数（2 的幂）
+    static constexpr uint32_t kBufferSize = 32;  // 每条槽位数（2 的幂）
+    static constexpr uint32_t kDrainThreshold = 16;  // 积累到该数量时批量处理
+
+    // 单条读缓冲独占缓存行，避免不同线程的写入计数互相干扰
+    struct alignas(64) ReadBuffer {
+        std::atomic<uint32_t> writeCount{0};  // 共享锁下由读线程递增
+        uint32_t readCount = 0;               // 只在独占锁下修改
+        std::atomic<NodeType*> slots[kBufferSize] = {};
+    };
+
+    static size_t stripeIndex() {
+        static std::atomic<size_t> nextThreadId{0};
+        thread_local size_t threadId = nextThreadId.fetch_add(1);
+        return threadId & (kStripeCount - 1);
+    }
+
+    // 记录一次命中（持有共享锁），返回是否应当尝试批量处理
+    bool recordRead(NodeType* node) {
+        ReadBuffer& buffer = readBuffers_[stripeIndex()];
+        uint32_t index =
+            buffer.writeCount.fetch_add(1, std::memory_order_relaxed);
+        uint32_t pending = index - buffer.readCount;
+        if (pending >= kBufferSize) {
+            // 缓冲已满，丢弃本次记录
+            return true;
+        }
+        buffer.slots[index & (kBufferSize - 1)].store(node,
+                                                      std::memory_order_relaxed);
+        return pending + 1 >= kDrainThreshold;
+    }
+
+    // 不阻塞地尝试获取独占锁，拿不到说明已有线程在处理或正在写入
+    void tryDrainReadBuffers() {
+        std::unique_lock<std::shared_mutex> lock(mutex_, std::try_to_lock);
+        if (lock.owns_lock()) {
+            drainReadBuffers();
+        }
+    }
+
+    // 批量重放读缓冲中的访问记录（必须持有独占锁）
+    void drainReadBuffers() {
+        for (size_t i = 0; i < kStripeCount; ++i) {
+            ReadBuffer& buffer = readBuffers_[i];
+            uint32_t writeCount =
+                buffer.writeCount.load(std::memory_order_relaxed);
+            uint32_t pending = writeCount - buffer.readCount;
+            if (pending > kBufferSize) {
+                pending = kBufferSize;
+            }
+            for (uint32_t j = 0; j < pending; ++j) {
+                auto& slot =
+                    buffer.slots[(buffer.readCount + j) & (kBufferSize - 1)];
+                NodeType* node = slot.load(std::memory_order_relaxed);
+                if (node) {
+                    moveToMostRecent(node);
+                    slot.store(nullptr, std::memory_order_relaxed);
+                }
+            }
+            buffer.readCount = writeCount;
+        }
+    }
+
+    template <typename... Args>
+    void addNewNode(const Key& key, Args&&... args) {
+        if (nodeMap_.size() >= capacity_) {
+            evictLeastRecent();
+        }
+        auto node =
+            std::make_unique<NodeType>(key, std::forward<Args>(args)...);
+        insertNode(node.get());
+        nodeMap_.emplace(key, std::move(node));
+    }
+
+    // 将该结点移动到最新的位置
+    void moveToMostRecent(NodeType* node) {
+        removeNode(node);
+        insertNode(node);
+    }
+
+    void removeNode(NodeType* node) {
+        node->prev_->next_ = node->next_;
+        node->next_->prev_ = node->prev_;
+    }
+
+    // 从尾部插入结点
+    void insertNode(NodeType* node) {
+        node->next_ = &dummy_;
+        node->prev_ = dummy_.prev_;
+        dummy_.prev_->next_ = node;
+        dummy_.prev_ = node;
+    }
+
+    // 缩容后淘汰至多 kResizeEvictionStep 个超额条目（必须持有独占锁）
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep &&
+                           nodeMap_.size() > capacity_;
+             ++n) {
+            evictLeastRecent();
+        }
+    }
+
+    // 驱逐最近最少访问
+    void evictLeastRecent() {
+        NodeType* leastRecent = dummy_.next_;
+        if (leastRecent == &dummy_) {
+            return;
+        }
+        removeNode(leastRecent);
+        // 先定位再按迭代器删除，避免以即将析构的结点中的 key 作为参数
+        nodeMap_.erase(nodeMap_.find(leastRecent->key_));
+        stats_.record(StatCounter::Evictions);
+    }
+
+   private:
+    size_t capacity_;  // 缓存容量
+    NodeMap nodeMap_;  // key -> 结点
+    NodeType dummy_;   // 哨兵结点，next_ 为最久未访问，prev_ 为最近访问
+    std::shared_mutex mutex_;
+    std::unique_ptr<ReadBuffer[]> readBuffers_;  // 分条读缓冲
+    StatsRecorder stats_;  // 命中、淘汰等统计计数
+};
+}  // namespace IncreCache
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ICacheKey.h"
+#include "IHashMix.h"
+
+namespace IncreCache {
+// 批量接口的预取距离：处理第 i 个键时预取第 i + 距离个键的槽位，
+// 控制组再提前一倍距离预取，保证读取控制字节时它已经到达缓存
+constexpr size_t kBatchPrefetchDistance = 8;
+
+// 按分片分组后的一批键
+struct ShardBatch {
+    std::vector<size_t> hashes;    // 每个键的 CacheHash 结果
+    std::vector<uint32_t> order;   // 按分片排列的键下标，同一分片内保持原顺序
+    std::vector<size_t> offsets;   // 第 s 个分片的下标位于
+                                   // order[offsets[s], offsets[s + 1])
+
+    std::span<const uint32_t> shard(size_t index) const {
+        return std::span<const uint32_t>(order).subspan(
+            offsets[index], offsets[index + 1] - offsets[index]);
+    }
+};
+
+// 一次性计算所有键的哈希，按 shardOf 选出的分片计数排序分组，
+// 与单键接口的分片选择一致
+template <typename Key>
+void groupByShard(std::span<const Key> keys, size_t shardCount,
+                  ShardBatch& batch) {
+    CacheHash<Key> hashFunc;
+    std::vector<uint32_t> shards(keys.size());
+    batch.hashes.resize(keys.size());
+    batch.order.resize(keys.size());
+    batch.offsets.assign(shardCount + 1, 0);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        batch.hashes[i] = hashFunc(keys[i]);
+        shards[i] = static_cast<uint32_t>(
+            shardOf(mixHash(batch.hashes[i]), shardCount));
+        ++batch.offsets[shards[i] + 1];
+    }
+    for (size_t s = 0; s < shardCount; ++s) {
+        batch.offsets[s + 1] += batch.offsets[s];
+    }
+    std::vector<size_t> next(batch.offsets.begin(), batch.offsets.end() - 1);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        batch.order[next[shards[i]]++] =
+            static_cast<uint32_t>(i);
+    }
+}
+
+// 批量接口的索引操作：FlatIndex 复用预先算好的哈希并预取探测位置；
+// std::unordered_map 不暴露桶的内存，退化为普通查找，预取为空操作
+template <typename Map, typename K>
+auto indexFind(Map& index, const K& key, size_t hash) {
+#ifdef INCRECACHE_STD_INDEX
+    (void)hash;
+    return index.find(key);
+#else
+    return index.find(key, hash);
+#endif
+}
+
+// 流水线预取：indices[position] 对应的键即将被探测
+template <typename Map>
+void indexPrefetch(const Map& index, std::span<const size_t> hashes,
+                   std::span<const uint32_t> indices, size_t position) {
+#ifdef INCRECACHE_STD_INDEX
+    (void)index;
+    (void)hashes;
+    (void)indices;
+    (void)position;
+#else
+    if (position == 0) {
+        // 流水线启动：前两段距离内的控制组此前没有被预取
+        for (size_t i = 0;
+             i < indices.size() && i < 2 * kBatchPrefetchDistance; ++i) {
+            index.prefetchGroup(hashes[indices[i]]);
+        }
+    }
+    if (position + 2 * kBatchPrefetchDistance < indices.size()) {
+        index.prefetchGroup(
+            hashes[indices[position + 2 * kBatchPrefetchDistance]]);
+    }
+    if (position + kBatchPrefetchDistance < indices.size()) {
+        index.prefetchSlot(hashes[indices[position + kBatchPrefetchDistance]]);
+    }
+#endif
+}
+}  // namespace IncreCache
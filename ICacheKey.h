@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "IFlatIndex.h"
+
+namespace IncreCache {
+// 缓存索引使用的哈希函数。Key 为 std::string 时哈希是透明的（is_transparent），
+// std::string、std::string_view、const char* 都按 std::string_view 计算，
+// 结果与 std::hash<std::string> 一致，查找时无需构造临时 std::string
+template <typename Key>
+struct CacheHash : std::hash<Key> {};
+
+template <>
+struct CacheHash<std::string> {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const noexcept {
+        return std::hash<std::string_view>()(key);
+    }
+};
+
+// 与 CacheHash 配套的相等比较，std::string 键使用透明的 std::equal_to<>
+template <typename Key>
+struct CacheKeyEqual : std::equal_to<Key> {};
+
+template <>
+struct CacheKeyEqual<std::string> : std::equal_to<> {};
+
+// 各策略的 key -> 结点索引，默认为开放寻址的 FlatIndex（见 IFlatIndex.h）；
+// 定义 INCRECACHE_STD_INDEX 时换回 std::unordered_map，便于对比测试。
+// 哈希与相等比较都透明时，find 可以直接接受 std::string_view 等异构键
+#ifdef INCRECACHE_STD_INDEX
+template <typename Key, typename T>
+using IndexMap = std::unordered_map<Key, T, CacheHash<Key>, CacheKeyEqual<Key>>;
+#else
+template <typename Key, typename T>
+using IndexMap = FlatIndex<Key, T, CacheHash<Key>, CacheKeyEqual<Key>>;
+#endif
+}  // namespace IncreCache
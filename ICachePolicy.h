@@ -1,6 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <utility>
+
+#include "ISingleFlight.h"
+
 namespace IncreCache {
+// 在线缩容时单次操作至多淘汰的条目数。各策略的 setCapacity 不一次淘汰完
+// 超出新容量的条目，而是由 setCapacity 和之后的每次读写分批淘汰，单次操作的
+// 耗时有上界；淘汰完成前的写入先淘汰再插入，不会增加超额部分。
+// 扩容只提高上限，索引随写入按需增长，不预先分配
+constexpr size_t kResizeEvictionStep = 16;
+
 template <typename Key, typename Value>
 class ICachePolicy {
    public:
@@ -15,4 +26,71 @@ class ICachePolicy {
     // 如果缓存中能找到参数 key，则直接返回 true
     virtual Value get(Key key) = 0;
 };
+
+// 静态多态（CRTP）前端：具体策略只需实现以下非虚接口
+//   template <typename V> void insertOrAssign(const Key&, V&&)
+//   template <typename... Args> bool emplace(const Key&, Args&&...)
+//   template <typename K> bool tryGet(const K&, Value&)
+//   template <typename K> bool peek(const K&, Value&)
+// 直接持有具体策略类型的调用方使用这些接口，可以完全内联，value 按转发引用
+// 传入并移动到结点中，tryGet 接受异构键（见 ICacheKey.h）；peek 与 tryGet
+// 相同但不调整访问顺序或频次，也不计入命中和未命中统计；
+// 需要运行时多态时仍可通过 ICachePolicy 指针访问，本类把虚函数转发到上述接口。
+// 基于上述接口，本类还为所有策略提供 getOrLoad
+template <typename Derived, typename Key, typename Value>
+class ICachePolicyAdapter : public ICachePolicy<Key, Value> {
+   public:
+    void put(Key key, Value value) override {
+        derived().insertOrAssign(key, std::move(value));
+    }
+
+    bool get(Key key, Value& value) override {
+        return derived().tryGet(key, value);
+    }
+
+    Value get(Key key) override {
+        Value value{};
+        derived().tryGet(key, value);
+        return value;
+    }
+
+    // 读取 key，未命中时调用 loader(key) 加载并写入缓存。
+    // 同一个键的并发未命中只有一个线程执行 loader，其余线程等待同一结果；
+    // loader 抛出的异常会传给所有等待的线程，失败的结果不写入缓存
+    template <typename Loader>
+    Value getOrLoad(const Key& key, Loader&& loader) {
+        bool loaded = false;
+        return getOrLoad(key, std::forward<Loader>(loader), loaded);
+    }
+
+    // 同上，loaded 返回本次调用是否执行了 loader 并写入缓存；
+    // 命中或等待其他线程的加载结果时为 false
+    template <typename Loader>
+    Value getOrLoad(const Key& key, Loader&& loader, bool& loaded) {
+        loaded = false;
+        Value value{};
+        if (derived().tryGet(key, value)) {
+            return value;
+        }
+        return flight_.run(key, [&]() -> Value {
+            // 上面未命中之后、登记本次加载之前，上一个领头者可能已经写入缓存
+            // 并结束加载，这里再查一次，保证同一个值只加载一次。
+            // 上面的未命中已经计入统计，这次用 peek，不再重复计数
+            Value cached{};
+            if (derived().peek(key, cached)) {
+                return cached;
+            }
+            Value result = loader(key);
+            // 先写入缓存再结束本次加载，之后到达的线程可以直接命中
+            derived().insertOrAssign(key, result);
+            loaded = true;
+            return result;
+        });
+    }
+
+   private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    SingleFlight<Key, Value> flight_;  // 进行中的 getOrLoad 加载
+};
 }  // namespace IncreCache
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace IncreCache {
+// 缓存统计项
+enum class StatCounter {
+    Hits,         // 读命中
+    Misses,       // 读未命中
+    Puts,         // 插入新键
+    Updates,      // 更新已有键
+    Evictions,    // 淘汰
+    GhostHits,    // 幽灵链表命中（ARC）
+    Admissions,   // 准入主缓存（LRU-K、W-TinyLFU）
+    Rejections,   // 拒绝准入（LRU-K、W-TinyLFU，以及超出字节预算的条目）
+    Expirations,  // 存活时间到期被回收（ILruCache、ILfuCache）
+    Count
+};
+
+// 统计快照，由 stats() 汇总各计数条后返回
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t puts = 0;
+    uint64_t updates = 0;
+    uint64_t evictions = 0;
+    uint64_t ghostHits = 0;
+    uint64_t admissions = 0;
+    uint64_t rejections = 0;
+    uint64_t expirations = 0;
+    size_t size = 0;  // 当前缓存的条目数
+    // 当前占用的权重（ILruCache、ILfuCache、IArcCache），
+    // 未设置 weigher 时等于条目数
+    size_t weight = 0;
+
+    double hitRate() const {
+        uint64_t lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / lookups : 0.0;
+    }
+
+    // 合并分片的统计
+    CacheStats& operator+=(const CacheStats& other) {
+        hits += other.hits;
+        misses += other.misses;
+        puts += other.puts;
+        updates += other.updates;
+        evictions += other.evictions;
+        ghostHits += other.ghostHits;
+        admissions += other.admissions;
+        rejections += other.rejections;
+        expirations += other.expirations;
+        size += other.size;
+        weight += other.weight;
+        return *this;
+    }
+};
+
+#ifndef INCRECACHE_DISABLE_STATS
+// 按线程分条的计数器：每个线程固定写入其中一条，每条独占一个缓存行，
+// 计数只做 relaxed 原子加，不与缓存的锁或其他线程争用；读取时再把各条相加
+class StatsRecorder {
+   public:
+    StatsRecorder() : stripes_(new Stripe[kStripeCount]) {}
+
+    void record(StatCounter counter, uint64_t n = 1) {
+        stripes_[stripeIndex()]
+            .counts[static_cast<size_t>(counter)]
+            .fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // 汇总所有计数条，size、weight 由调用方填写
+    CacheStats snapshot() const {
+        uint64_t totals[kCounterCount] = {};
+        for (size_t i = 0; i < kStripeCount; ++i) {
+            for (size_t j = 0; j < kCounterCount; ++j) {
+                totals[j] +=
+                    stripes_[i].counts[j].load(std::memory_order_relaxed);
+            }
+        }
+        CacheStats stats;
+        stats.hits = totals[static_cast<size_t>(StatCounter::Hits)];
+        stats.misses = totals[static_cast<size_t>(StatCounter::Misses)];
+        stats.puts = totals[static_cast<size_t>(StatCounter::Puts)];
+        stats.updates = totals[static_cast<size_t>(StatCounter::Updates)];
+        stats.evictions = totals[static_cast<size_t>(StatCounter::Evictions)];
+        stats.ghostHits = totals[static_cast<size_t>(StatCounter::GhostHits)];
+        stats.admissions =
+            totals[static_cast<size_t>(StatCounter::Admissions)];
+        stats.rejections =
+            totals[static_cast<size_t>(StatCounter::Rejections)];
+        stats.expirations =
+            totals[static_cast<size_t>(StatCounter::Expirations)];
+        return stats;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < kStripeCount; ++i) {
+            for (size_t j = 0; j < kCounterCount; ++j) {
+                stripes_[i].counts[j].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+   private:
+    static constexpr size_t kStripeCount = 16;  // 计数条数（2 的幂）
+    static constexpr size_t kCounterCount =
+        static_cast<size_t>(StatCounter::Count);
+
+    // 按缓存行对齐，不同线程的计数条不会共享缓存行
+    struct alignas(64) Stripe {
+        std::atomic<uint64_t> counts[kCounterCount] = {};
+    };
+
+    static size_t stripeIndex() {
+        static std::atomic<size_t> nextThreadId{0};
+        thread_local size_t threadId = nextThreadId.fetch_add(1);
+        return threadId & (kStripeCount - 1);
+    }
+
+    std::unique_ptr<Stripe[]> stripes_;
+};
+#else
+// 编译期关闭统计：所有记录调用都是空函数，会被编译器完全消除
+class StatsRecorder {
+   public:
+    void record(StatCounter, uint64_t = 1) {}
+
+    CacheStats snapshot() const { return CacheStats(); }
+
+    void reset() {}
+};
+#endif
+}  // namespace IncreCache
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace IncreCache {
+// 用户提供的权重函数：返回键和值在对象本身之外占用的堆内存字节数，
+// 例如 std::string 的 capacity()、std::vector 的 capacity() * sizeof(T)
+template <typename Key, typename Value>
+using CacheWeigher = std::function<size_t(const Key&, const Value&)>;
+
+// glibc malloc 为 bytes 字节的请求实际占用的块大小：
+// 8 字节块头，按 16 字节对齐，最小 32 字节
+constexpr size_t mallocChunkSize(size_t bytes) {
+    return std::max<size_t>(32, (bytes + 8 + 15) & ~static_cast<size_t>(15));
+}
+
+// make_shared 创建的结点：控制块（虚表指针和两个引用计数）与对象在同一块内存中
+template <typename Node>
+constexpr size_t sharedNodeBytes() {
+    return mallocChunkSize(16 + sizeof(Node));
+}
+
+// std::list 的一个结点：前后指针加元素
+template <typename T>
+constexpr size_t listNodeBytes() {
+    return mallocChunkSize(2 * sizeof(void*) + sizeof(T));
+}
+
+// 索引中一个条目摊销的字节数。FlatIndex 的槽位和控制字节连续分配，
+// 按负载上限 7/8 摊销；unordered_map 每个条目一个堆结点（next 指针、
+// 键值对和缓存的哈希值），另加一个桶指针
+template <typename Key, typename T>
+constexpr size_t indexEntryBytes() {
+#ifdef INCRECACHE_STD_INDEX
+    return mallocChunkSize(sizeof(void*) + sizeof(std::pair<const Key, T>) +
+                           sizeof(size_t)) +
+           sizeof(void*);
+#else
+    return (sizeof(std::pair<Key, T>) + 1) * 8 / 7;
+#endif
+}
+
+// 结点由 make_shared 分配、索引保存结点 shared_ptr 的策略中，每个条目的
+// 固定开销：结点所在的内存块加上索引中的一个条目。结点还挂在其他容器上的
+// 策略（例如 std::list 频次链表）再加上那部分开销
+template <typename Key, typename Node>
+constexpr size_t sharedEntryBytes() {
+    return sharedNodeBytes<Node>() +
+           indexEntryBytes<Key, std::shared_ptr<Node>>();
+}
+
+// 条目权重的计算方式。未设置权重函数时每个条目计 1，容量即条目数；
+// 设置后条目权重为权重函数的结果加上 overhead（结点和索引的固定开销，
+// 由各策略按自己的结点布局给出），容量即字节预算，接近实际占用的内存
+template <typename Key, typename Value>
+class EntryWeigher {
+   public:
+    EntryWeigher() : overhead_(0) {}
+
+    EntryWeigher(CacheWeigher<Key, Value> weigher, size_t overhead)
+        : weigher_(std::move(weigher)), overhead_(overhead) {}
+
+    bool weighted() const { return static_cast<bool>(weigher_); }
+
+    size_t operator()(const Key& key, const Value& value) const {
+        return weigher_ ? overhead_ + weigher_(key, value) : 1;
+    }
+
+   private:
+    CacheWeigher<Key, Value> weigher_;
+    size_t overhead_;  // 每个条目的固定开销（字节）
+};
+}  // namespace IncreCache
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ICacheKey.h"
+#include "ICachePolicy.h"
+#include "ICacheStats.h"
+#include "ISegmentedArray.h"
+
+namespace IncreCache {
+// CLOCK 近似 LRU：命中只在共享锁下置位条目的原子引用位，不调整任何链表；
+// 淘汰时时钟指针在环形数组上扫描，引用位为 1 的条目清零并获得第二次机会，
+// 遇到引用位为 0 的条目即将其淘汰。扩容时环形数组追加新段，已有槽位不移动
+template <typename Key, typename Value>
+class IClockCache
+    : public ICachePolicyAdapter<IClockCache<Key, Value>, Key, Value> {
+   public:
+    explicit IClockCache(int capacity)
+        : capacity_(capacity > 0 ? capacity : 0),
+          hand_(0),
+          used_(0),
+          slots_(capacity_) {
+        nodeMap_.reserve(capacity_);
+    }
+
+    ~IClockCache() override = default;
+
+    // 插入或更新，右值 value 直接移动到槽位中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return;
+        }
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            Slot& slot = slots_[it->second];
+            slot.value = std::forward<V>(value);
+            markReferenced(slot);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        addNewSlot(key, std::forward<V>(value));
+        stats_.record(StatCounter::Puts);
+    }
+
+    // 键不存在时用 args 构造 value 并插入，返回是否插入；键已存在时不做任何修改
+    // 槽位中的 value 是预先构造好的，这里构造临时对象后移动赋值进去
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return false;
+        }
+        if (nodeMap_.find(key) != nodeMap_.end()) {
+            return false;
+        }
+        addNewSlot(key, Value(std::forward<Args>(args)...));
+        stats_.record(StatCounter::Puts);
+        return true;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            stats_.record(StatCounter::Misses);
+            return false;
+        }
+        Slot& slot = slots_[it->second];
+        value = slot.value;
+        markReferenced(slot);
+        stats_.record(StatCounter::Hits);
+        return true;
+    }
+
+    // 读取 value，不设置引用位，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            return false;
+        }
+        value = slots_[it->second].value;
+        return true;
+    }
+
+    // 删除指定元素，槽位留给后续插入复用
+    template <typename K>
+    void remove(const K& key) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            uint32_t index = it->second;
+            nodeMap_.erase(it);
+            releaseSlot(index);
+        }
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        result.size = nodeMap_.size();
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 在线调整容量（见 kResizeEvictionStep）。扩容时环形数组追加新段，已有槽位
+    // 不移动；读操作只持有共享锁，超额条目只由写入分批淘汰。
+    // 缩容不归还槽位，被淘汰的 value 已释放
+    void setCapacity(size_t capacity) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        slots_.grow(capacity);
+        capacity_ = capacity;
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return capacity_;
+    }
+
+   private:
+    struct Slot {
+        Key key{};
+        Value value{};
+        std::atomic<uint8_t> referenced{0};  // 引用位，命中时置 1
+        bool occupied = false;
+    };
+
+    // 先读后写，引用位已经置位时不再写入，避免热点条目所在缓存行反复失效
+    static void markReferenced(Slot& slot) {
+        if (!slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename V>
+    void addNewSlot(const Key& key, V&& value) {
+        uint32_t index;
+        if (nodeMap_.size() >= capacity_) {
+            // 缩容后超额条目尚未淘汰完时，淘汰一个再插入，不增加超额部分
+            index = evictOne();
+        } else if (!freeSlots_.empty()) {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            index = static_cast<uint32_t>(used_++);
+        }
+        Slot& slot = slots_[index];
+        slot.key = key;
+        slot.value = std::forward<V>(value);
+        slot.occupied = true;
+        // 新条目引用位为 0，若此后未被访问则在下一轮扫描中被淘汰
+        slot.referenced.store(0, std::memory_order_relaxed);
+        nodeMap_[key] = index;
+    }
+
+    // 缩容后淘汰至多 kResizeEvictionStep 个超额条目，腾出的槽位留给后续插入
+    void shrinkStep() {
+        for (size_t n = 0;
+             n < kResizeEvictionStep && nodeMap_.size() > capacity_; ++n) {
+            uint32_t index = evictOne();
+            slots_[index].value = Value();
+            freeSlots_.push_back(index);
+        }
+    }
+
+    void releaseSlot(uint32_t index) {
+        Slot& slot = slots_[index];
+        slot.occupied = false;
+        slot.value = Value();
+        slot.referenced.store(0, std::memory_order_relaxed);
+        freeSlots_.push_back(index);
+    }
+
+    // 时钟指针扫描：清除引用位直到找到未被引用的条目，返回被腾出的槽位。
+    // 指针在所有用过的槽位上转动，缩容后位于容量之外的条目同样会被扫到
+    uint32_t evictOne() {
+        while (true) {
+            Slot& slot = slots_[hand_];
+            uint32_t index = static_cast<uint32_t>(hand_);
+            hand_ = (hand_ + 1) % used_;
+            if (!slot.occupied) {
+                continue;
+            }
+            if (slot.referenced.load(std::memory_order_relaxed)) {
+                slot.referenced.store(0, std::memory_order_relaxed);
+                continue;
+            }
+            nodeMap_.erase(nodeMap_.find(slot.key));
+            slot.occupied = false;
+            stats_.record(StatCounter::Evictions);
+            return index;
+        }
+    }
+
+   private:
+    size_t capacity_;                           // 缓存容量
+    size_t hand_;                               // 时钟指针
+    size_t used_;                               // 用过的槽位数，指针在其中转动
+    SegmentedArray<Slot> slots_;                // 环形数组
+    std::vector<uint32_t> freeSlots_;           // remove 和缩容腾出的空槽位
+    IndexMap<Key, uint32_t> nodeMap_;           // key -> 槽位下标
+    std::shared_mutex mutex_;
+    StatsRecorder stats_;                       // 命中、淘汰等统计计数
+};
+}  // namespace IncreCache
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "IHashMix.h"
+
+namespace IncreCache {
+// 一组 16 个控制字节：空槽为 kEmpty，删除标记为 kDeleted，
+// 占用槽保存哈希值的低 7 位（h2，取值 0 ~ 127）。
+// 查找时一次比较整组控制字节，得到每个匹配字节对应一位的掩码
+struct alignas(16) FlatIndexGroup {
+    static constexpr size_t kWidth = 16;
+    static constexpr int8_t kEmpty = -128;
+    static constexpr int8_t kDeleted = -2;
+
+    int8_t ctrl[kWidth];
+
+#if defined(__SSE2__)
+    uint32_t match(int8_t h2) const {
+        __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)));
+    }
+
+    // 空槽或删除标记都小于 -1
+    uint32_t matchEmptyOrDeleted() const {
+        __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)));
+    }
+#else
+    // 没有 SSE2 时逐字节比较，结果与 SIMD 版本相同
+    uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t matchEmptyOrDeleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl[i] < -1) << i;
+        }
+        return mask;
+    }
+#endif
+
+    uint32_t matchEmpty() const { return match(kEmpty); }
+};
+
+// 指向槽位的迭代器，只支持解引用和比较（策略只用 find/erase，不做遍历）
+template <typename Slot>
+class FlatIndexIterator {
+   public:
+    FlatIndexIterator() : slot_(nullptr) {}
+
+    explicit FlatIndexIterator(Slot* slot) : slot_(slot) {}
+
+    Slot& operator*() const { return *slot_; }
+
+    Slot* operator->() const { return slot_; }
+
+    bool operator==(const FlatIndexIterator& other) const {
+        return slot_ == other.slot_;
+    }
+
+    bool operator!=(const FlatIndexIterator& other) const {
+        return slot_ != other.slot_;
+    }
+
+   private:
+    Slot* slot_;
+};
+
+// Swiss table 风格的开放寻址哈希表，作为各策略 key -> 结点的索引。
+// 控制字节与槽位分别存放在两个连续数组中：查找先用 SIMD 比较一组控制字节，
+// 只有 h2 匹配的槽位才比较键，通常只访问一个控制组和一个槽位所在的缓存行；
+// 按组做三角数探测，组内出现空槽即可判定键不存在。
+// 键值对直接存放在槽位中，不再为每个条目单独分配结点。
+// 负载上限为 7/8（含删除标记），扩容或清理删除标记时整体重新散列，
+// 此时迭代器和元素引用失效
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+class FlatIndex {
+   public:
+    using value_type = std::pair<Key, T>;
+    using iterator = FlatIndexIterator<value_type>;
+    using const_iterator = FlatIndexIterator<const value_type>;
+
+    FlatIndex() : groupCount_(0), size_(0), deleted_(0), growthLeft_(0) {}
+
+    FlatIndex(const FlatIndex&) = delete;
+    FlatIndex& operator=(const FlatIndex&) = delete;
+
+    ~FlatIndex() { destroySlots(); }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    iterator end() { return iterator(); }
+
+    const_iterator end() const { return const_iterator(); }
+
+    // K 可以是 Key，也可以是 Hash/KeyEqual 接受的其他类型（异构查找）
+    template <typename K>
+    iterator find(const K& key) {
+        return iterator(findSlot(key));
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const {
+        return const_iterator(findSlot(key));
+    }
+
+    // hash 为预先算好的 Hash 结果，批量查找时与分片选择共用，不再重复计算
+    template <typename K>
+    iterator find(const K& key, size_t hash) {
+        return iterator(findSlot(key, mixHash(static_cast<uint64_t>(hash))));
+    }
+
+    // 批量查找的两级预取：先预取探测起点的控制组，
+    // 等控制组到达缓存后再按 h2 预取第一个匹配的槽位
+    void prefetchGroup(size_t hash) const {
+        if (groupCount_ > 0) {
+            __builtin_prefetch(&groups_[groupOf(mixHash(hash))]);
+        }
+    }
+
+    void prefetchSlot(size_t hash) const {
+        if (groupCount_ == 0) {
+            return;
+        }
+        uint64_t mixed = mixHash(static_cast<uint64_t>(hash));
+        size_t group = groupOf(mixed);
+        uint32_t bits = groups_[group].match(h2Of(mixed));
+        if (bits != 0) {
+            size_t index = group * Group::kWidth + __builtin_ctz(bits);
+            __builtin_prefetch(slotAt(index));
+        }
+    }
+
+    // 键不存在时插入 value，返回元素位置和是否插入
+    template <typename V>
+    std::pair<iterator, bool> emplace(const Key& key, V&& value) {
+        return tryEmplace(key, std::forward<V>(value));
+    }
+
+    T& operator[](const Key& key) { return tryEmplace(key).first->second; }
+
+    void erase(iterator it) { eraseAt(indexOf(&*it)); }
+
+    template <typename K>
+    size_t erase(const K& key) {
+        value_type* slot = findSlot(key);
+        if (slot == nullptr) {
+            return 0;
+        }
+        eraseAt(indexOf(slot));
+        return 1;
+    }
+
+    // 预留至少容纳 count 个元素的空间，避免插入过程中重新散列
+    void reserve(size_t count) {
+        size_t groups = groupCount_ > 0 ? groupCount_ : 1;
+        while (maxLoadOf(groups) < count) {
+            groups *= 2;
+        }
+        if (groups > groupCount_) {
+            rehash(groups);
+        }
+    }
+
+    // 清空所有元素，保留已分配的内存
+    void clear() {
+        destroySlots();
+        resetControl();
+        size_ = 0;
+        deleted_ = 0;
+        growthLeft_ = maxLoadOf(groupCount_);
+    }
+
+   private:
+    using Group = FlatIndexGroup;
+
+    struct SlotStorage {
+        alignas(value_type) unsigned char bytes[sizeof(value_type)];
+    };
+
+    static size_t maxLoadOf(size_t groups) {
+        return groups * Group::kWidth / 8 * 7;
+    }
+
+    // 高位定位起始组，低 7 位作为控制字节；
+    // 先混淆，避免 std::hash 的恒等映射聚集在少数几组
+    template <typename K>
+    uint64_t hashOf(const K& key) const {
+        return mixHash(static_cast<uint64_t>(hash_(key)));
+    }
+
+    static int8_t h2Of(uint64_t hash) {
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    size_t groupOf(uint64_t hash) const {
+        return static_cast<size_t>(hash >> 7) & (groupCount_ - 1);
+    }
+
+    value_type* slotAt(size_t index) const {
+        return std::launder(reinterpret_cast<value_type*>(slots_[index].bytes));
+    }
+
+    size_t indexOf(const value_type* slot) const {
+        return static_cast<size_t>(
+            reinterpret_cast<const SlotStorage*>(slot) - slots_.get());
+    }
+
+    int8_t& ctrlAt(size_t index) {
+        return groups_[index / Group::kWidth].ctrl[index % Group::kWidth];
+    }
+
+    template <typename K>
+    value_type* findSlot(const K& key) const {
+        return findSlot(key, hashOf(key));
+    }
+
+    // hash 为混淆后的哈希值
+    template <typename K>
+    value_type* findSlot(const K& key, uint64_t hash) const {
+        if (groupCount_ == 0) {
+            return nullptr;
+        }
+        int8_t h2 = h2Of(hash);
+        size_t group = groupOf(hash);
+        for (size_t step = 1;; ++step) {
+            const Group& ctrl = groups_[group];
+            for (uint32_t bits = ctrl.match(h2); bits != 0; bits &= bits - 1) {
+                size_t index = group * Group::kWidth + __builtin_ctz(bits);
+                value_type* slot = slotAt(index);
+                if (equal_(slot->first, key)) {
+                    return slot;
+                }
+            }
+            if (ctrl.matchEmpty() != 0) {
+                return nullptr;
+            }
+            // 三角数探测：组数为 2 的幂时可以遍历所有组
+            group = (group + step) & (groupCount_ - 1);
+        }
+    }
+
+    // 沿探测序列找到第一个空槽或删除标记
+    size_t findInsertIndex(uint64_t hash) const {
+        size_t group = groupOf(hash);
+        for (size_t step = 1;; ++step) {
+            uint32_t bits = groups_[group].matchEmptyOrDeleted();
+            if (bits != 0) {
+                return group * Group::kWidth + __builtin_ctz(bits);
+            }
+            group = (group + step) & (groupCount_ - 1);
+        }
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> tryEmplace(const Key& key, Args&&... args) {
+        value_type* found = findSlot(key);
+        if (found != nullptr) {
+            return {iterator(found), false};
+        }
+        if (growthLeft_ == 0) {
+            growOrCleanup();
+        }
+        uint64_t hash = hashOf(key);
+        size_t index = findInsertIndex(hash);
+        value_type* slot = slotAt(index);
+        new (slot) value_type(
+            std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        int8_t& ctrl = ctrlAt(index);
+        if (ctrl == Group::kDeleted) {
+            --deleted_;
+        } else {
+            --growthLeft_;
+        }
+        ctrl = h2Of(hash);
+        ++size_;
+        return {iterator(slot), true};
+    }
+
+    void eraseAt(size_t index) {
+        slotAt(index)->~value_type();
+        --size_;
+        // 组内还有空槽时，任何探测都不会越过这一组，可以直接置为空槽；
+        // 否则必须留下删除标记，保证经过该组的探测继续向后查找
+        if (groups_[index / Group::kWidth].matchEmpty() != 0) {
+            ctrlAt(index) = Group::kEmpty;
+            ++growthLeft_;
+        } else {
+            ctrlAt(index) = Group::kDeleted;
+            ++deleted_;
+        }
+    }
+
+    // 删除标记较多时原地清理，否则容量翻倍
+    void growOrCleanup() {
+        if (groupCount_ > 0 && size_ * 2 <= maxLoadOf(groupCount_)) {
+            rehash(groupCount_);
+        } else {
+            rehash(groupCount_ > 0 ? groupCount_ * 2 : 1);
+        }
+    }
+
+    void rehash(size_t groups) {
+        std::unique_ptr<Group[]> oldGroups = std::move(groups_);
+        std::unique_ptr<SlotStorage[]> oldSlots = std::move(slots_);
+        size_t oldCapacity = groupCount_ * Group::kWidth;
+
+        groups_.reset(new Group[groups]);
+        slots_.reset(new SlotStorage[groups * Group::kWidth]);
+        groupCount_ = groups;
+        resetControl();
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldGroups[i / Group::kWidth].ctrl[i % Group::kWidth] < 0) {
+                continue;
+            }
+            value_type* from =
+                std::launder(reinterpret_cast<value_type*>(oldSlots[i].bytes));
+            uint64_t hash = hashOf(from->first);
+            size_t index = findInsertIndex(hash);
+            new (slotAt(index)) value_type(std::move(*from));
+            ctrlAt(index) = h2Of(hash);
+            from->~value_type();
+        }
+        deleted_ = 0;
+        growthLeft_ = maxLoadOf(groupCount_) - size_;
+    }
+
+    void resetControl() {
+        for (size_t i = 0; i < groupCount_; ++i) {
+            std::memset(groups_[i].ctrl,
+                        static_cast<unsigned char>(Group::kEmpty),
+                        Group::kWidth);
+        }
+    }
+
+    void destroySlots() {
+        for (size_t i = 0; i < groupCount_ * Group::kWidth; ++i) {
+            if (ctrlAt(i) >= 0) {
+                slotAt(i)->~value_type();
+            }
+        }
+    }
+
+   private:
+    std::unique_ptr<Group[]> groups_;       // 控制字节，每组 16 个
+    std::unique_ptr<SlotStorage[]> slots_;  // 与控制字节一一对应的键值槽位
+    size_t groupCount_;                     // 组数，0 或 2 的幂
+    size_t size_;                           // 元素个数
+    size_t deleted_;                        // 删除标记个数
+    size_t growthLeft_;                     // 触发重新散列前还能占用的空槽数
+    Hash hash_;
+    KeyEqual equal_;
+};
+}  // namespace IncreCache
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "IHashMix.h"
+
+namespace IncreCache {
+// 门卫布隆过滤器：键第一次出现只记录在这里，出现第二次才进入计数器，
+// 过滤掉大量只访问一次的键对 Count-Min Sketch 的污染
+class Doorkeeper {
+   public:
+    explicit Doorkeeper(size_t expectedInsertions) {
+        size_t bits = 64;
+        while (bits < expectedInsertions * 8) {
+            bits <<= 1;
+        }
+        bits_.assign(bits / 64, 0);
+        bitMask_ = bits - 1;
+    }
+
+    // 检查是否存在
+    bool contains(uint64_t hash) const {
+        for (int i = 0; i < kHashCount; ++i) {
+            size_t bit = indexOf(hash, i);
+            if (!(bits_[bit >> 6] & (1ULL << (bit & 63)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 插入，插入前已存在返回 true
+    bool put(uint64_t hash) {
+        bool present = true;
+        for (int i = 0; i < kHashCount; ++i) {
+            size_t bit = indexOf(hash, i);
+            uint64_t mask = 1ULL << (bit & 63);
+            if (!(bits_[bit >> 6] & mask)) {
+                present = false;
+                bits_[bit >> 6] |= mask;
+            }
+        }
+        return present;
+    }
+
+    void clear() { std::fill(bits_.begin(), bits_.end(), 0); }
+
+    // 扩大到能容纳 expectedInsertions 个键。位数组每次翻倍并把原内容复制到
+    // 新增的一半，按新掩码取到的位与原来按旧掩码取到的相同，已记录的键仍然存在
+    void grow(size_t expectedInsertions) {
+        while (bits_.size() * 64 < expectedInsertions * 8) {
+            size_t words = bits_.size();
+            bits_.resize(words * 2);
+            std::copy_n(bits_.begin(), words, bits_.begin() + words);
+        }
+        bitMask_ = bits_.size() * 64 - 1;
+    }
+
+   private:
+    static constexpr int kHashCount = 3;
+
+    size_t indexOf(uint64_t hash, int i) const {
+        // 双重哈希：h1 + i * h2
+        uint64_t h1 = hash;
+        uint64_t h2 = (hash >> 32) | 1;
+        return static_cast<size_t>(h1 + i * h2) & bitMask_;
+    }
+
+    std::vector<uint64_t> bits_;
+    size_t bitMask_;
+};
+
+// 4 位计数器的 Count-Min Sketch，一个 uint64_t 存放 16 个计数器
+// 累计增加次数达到采样窗口后所有计数器减半，使频率估计随时间老化
+class FrequencySketch {
+   public:
+    explicit FrequencySketch(size_t capacity)
+        : doorkeeper_(capacity > 0 ? capacity : 1), additions_(0) {
+        size_t words = 1;
+        while (words < capacity) {
+            words <<= 1;
+        }
+        table_.assign(words, 0);
+        tableMask_ = words - 1;
+        sampleSize_ = 10 * (capacity > 0 ? capacity : 1);
+    }
+
+    // 记录一次访问
+    void increment(uint64_t hash) {
+        hash = mixHash(hash);
+        // 第一次出现只进入门卫
+        if (!doorkeeper_.put(hash)) {
+            return;
+        }
+        bool added = false;
+        for (int i = 0; i < kDepth; ++i) {
+            added |= incrementAt(hash, i);
+        }
+        if (added && ++additions_ >= sampleSize_) {
+            reset();
+        }
+    }
+
+    // 容量变大时扩大计数器表，与门卫一样翻倍复制，已有的频率估计不变；
+    // 容量变小时保留原有的表
+    void grow(size_t capacity) {
+        while (table_.size() < capacity) {
+            size_t words = table_.size();
+            table_.resize(words * 2);
+            std::copy_n(table_.begin(), words, table_.begin() + words);
+        }
+        tableMask_ = table_.size() - 1;
+        doorkeeper_.grow(capacity);
+        sampleSize_ = std::max(sampleSize_, 10 * capacity);
+    }
+
+    // 估计访问频率，取各行计数器的最小值，再加上门卫中的一次
+    int frequency(uint64_t hash) const {
+        hash = mixHash(hash);
+        int freq = kMaxCount;
+        for (int i = 0; i < kDepth; ++i) {
+            size_t word;
+            int shift;
+            locate(hash, i, word, shift);
+            int count = static_cast<int>((table_[word] >> shift) & 0xfULL);
+            if (count < freq) {
+                freq = count;
+            }
+        }
+        return freq + (doorkeeper_.contains(hash) ? 1 : 0);
+    }
+
+   private:
+    static constexpr int kDepth = 4;
+    static constexpr int kMaxCount = 15;
+
+    void locate(uint64_t hash, int i, size_t& word, int& shift) const {
+        // 每一行使用不同的种子重新混淆
+        static constexpr uint64_t kSeeds[kDepth] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+            0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+        uint64_t h = mixHash(hash + kSeeds[i]);
+        word = static_cast<size_t>(h) & tableMask_;
+        shift = static_cast<int>((h >> 60) & 0xfULL) << 2;
+    }
+
+    bool incrementAt(uint64_t hash, int i) {
+        size_t word;
+        int shift;
+        locate(hash, i, word, shift);
+        uint64_t mask = 0xfULL << shift;
+        if ((table_[word] & mask) == mask) {
+            return false;
+        }
+        table_[word] += 1ULL << shift;
+        return true;
+    }
+
+    // 所有计数器减半，门卫清空
+    void reset() {
+        for (auto& word : table_) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        additions_ /= 2;
+        doorkeeper_.clear();
+    }
+
+    std::vector<uint64_t> table_;
+    size_t tableMask_;
+    Doorkeeper doorkeeper_;
+    size_t additions_;   // 自上次减半以来的增加次数
+    size_t sampleSize_;  // 采样窗口大小
+};
+}  // namespace IncreCache
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IncreCache {
+// 64 位哈希混淆（splitmix64 的收尾步骤），使 std::hash 的恒等映射也能均匀分布
+inline uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+// 分片选择：取混淆后哈希的高 32 位做乘法-移位，均匀映射到 [0, count)，
+// 不需要取模的整数除法；count 为 2 的幂时结果正好是最高的 log2(count) 位。
+// FlatIndex 用同一混淆结果的低位（低 7 位作控制字节，其上的位定位组），
+// 分片内的组数小于 2^25 时两者用到的位互不重叠，
+// 落到同一分片的键在分片内的索引中仍然均匀分布
+inline size_t shardOf(uint64_t mixed, size_t count) {
+    return static_cast<size_t>(((mixed >> 32) * count) >> 32);
+}
+}  // namespace IncreCache
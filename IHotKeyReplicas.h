@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ICacheKey.h"
+#include "ICacheStats.h"
+#include "IShardArray.h"
+#include "ITimingWheel.h"
+
+namespace IncreCache {
+constexpr size_t kHotKeySketchSize = 32;      // 每个分片的 Space-Saving 计数器数
+constexpr uint32_t kHotKeySampleInterval = 32;  // 每个线程每隔多少次读采样一次
+constexpr uint32_t kHotKeyRefreshSamples = 128;  // 每个线程每采样多少次刷新一次
+constexpr uint64_t kHotKeyMinSamples = 256;  // 样本数不足时不提升任何键
+constexpr uint64_t kHotKeyDecaySamples = 4096;  // 样本数达到后计数减半
+constexpr size_t kHotKeyMaxKeys = 8;         // 默认最多复制的热点键数
+constexpr double kHotKeyMinShare = 0.01;     // 默认的提升阈值（占总读取的比例）
+
+// Space-Saving 热点统计：固定数量的计数器，键已被跟踪时计数 +1，
+// 否则顶替计数最小的计数器，新计数为最小值 +1，最小值记为误差上界。
+// 出现比例超过 1 / 计数器数 的键一定在计数器中，count 是其出现次数的估计，
+// 偏高不超过 error
+template <typename Key>
+class SpaceSaving {
+   public:
+    struct Counter {
+        Key key;
+        uint64_t hash;  // 混淆后的哈希，比较键之前先比较哈希
+        uint64_t count;
+        uint64_t error;
+    };
+
+    explicit SpaceSaving(size_t capacity) : capacity_(capacity), total_(0) {
+        counters_.reserve(capacity_);
+    }
+
+    template <typename K>
+    void offer(const K& key, uint64_t hash) {
+        ++total_;
+        CacheKeyEqual<Key> equal;
+        for (Counter& counter : counters_) {
+            if (counter.hash == hash && equal(counter.key, key)) {
+                ++counter.count;
+                return;
+            }
+        }
+        if (counters_.size() < capacity_) {
+            counters_.push_back(Counter{Key(key), hash, 1, 0});
+            return;
+        }
+        auto minimum = std::min_element(
+            counters_.begin(), counters_.end(),
+            [](const Counter& a, const Counter& b) { return a.count < b.count; });
+        *minimum =
+            Counter{Key(key), hash, minimum->count + 1, minimum->count};
+    }
+
+    const std::vector<Counter>& counters() const { return counters_; }
+
+    uint64_t total() const { return total_; }
+
+    // 计数和误差减半，计数归零的计数器被移除
+    void decay() {
+        total_ /= 2;
+        for (Counter& counter : counters_) {
+            counter.count /= 2;
+            counter.error /= 2;
+        }
+        counters_.erase(
+            std::remove_if(counters_.begin(), counters_.end(),
+                           [](const Counter& c) { return c.count == 0; }),
+            counters_.end());
+    }
+
+   private:
+    size_t capacity_;
+    uint64_t total_;  // 样本总数
+    std::vector<Counter> counters_;
+};
+
+// 热点键副本：每个分片用 Space-Saving 统计对读取采样，定期把占总读取比例
+// 超过阈值的键提升到前端，复制到按线程分条的多个副本中。读热点键的线程只锁
+// 自己那一条副本，不再争抢热点键所在分片的锁。
+// 副本保存的是分片结点的只读句柄 Handle（如 LruHandle，需提供 value() 和
+// retired()）及其过期时刻：结点被钉住后更新会换上新结点，旧结点被淘汰、
+// 到期、删除或替换时由分片标记为 retired，副本命中前检查标记和过期时刻，
+// 不会读到分片中已经不存在的值。写入热点键后再调用 invalidate 及时移除副本
+// 中的失效条目。适合读多写少的热点，频繁写入的热点键每次写入都要锁住全部副本
+template <typename Key, typename Value, typename Handle>
+class HotKeyReplicas {
+   public:
+    HotKeyReplicas(size_t shardCount, size_t maxKeys, double minShare)
+        : maxKeys_(maxKeys),
+          minShare_(minShare),
+          sketches_(shardCount, kHotKeySketchSize),
+          replicas_(std::bit_ceil(
+              std::max<size_t>(1, std::thread::hardware_concurrency()))),
+          filter_(0) {}
+
+    // 每 kHotKeySampleInterval 次读取采样一次，shard 为键所在分片；
+    // 返回本次读取是否被采样，refresh 返回是否到了刷新的时机。
+    // 计数按副本分条保存在本实例中，不同缓存实例互不影响
+    template <typename K>
+    bool sample(const K& key, uint64_t hash, size_t shard, bool& refresh) {
+        refresh = false;
+        Replica& replica = replicas_[replicaIndex()];
+        if ((replica.reads.fetch_add(1, std::memory_order_relaxed) + 1) %
+                kHotKeySampleInterval !=
+            0) {
+            return false;
+        }
+        Sketch& sketch = sketches_[shard];
+        // 统计只是估计，统计锁忙时放弃本次样本，不让读者排队
+        std::unique_lock<std::mutex> lock(sketch.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return true;
+        }
+        sketch.counter.offer(key, hash);
+        lock.unlock();
+        refresh = (replica.samples.fetch_add(1, std::memory_order_relaxed) +
+                   1) % kHotKeyRefreshSamples ==
+                  0;
+        return true;
+    }
+
+    // 键是热点时从本线程的副本读取，命中返回 true
+    template <typename K>
+    bool tryGet(const K& key, uint64_t hash, Value& value) {
+        if ((filter_.load(std::memory_order_acquire) & filterBit(hash)) == 0) {
+            return false;
+        }
+        Replica& replica = replicas_[replicaIndex()];
+        std::lock_guard<std::mutex> lock(replica.mutex);
+        CacheKeyEqual<Key> equal;
+        for (const Entry& entry : replica.entries) {
+            if (entry.hash == hash && equal(entry.key, key)) {
+                // 结点已离开分片或已到期时交给分片处理
+                if (entry.handle->retired() ||
+                    (entry.expireAt != 0 &&
+                     steadyNowMillis() >= entry.expireAt)) {
+                    return false;
+                }
+                value = entry.handle->value();
+                stats_.record(StatCounter::Hits);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 写入分片之后调用，移除所有副本中的 key，释放对旧结点的引用
+    template <typename K>
+    void invalidate(const K& key, uint64_t hash) {
+        if ((filter_.load() & filterBit(hash)) == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(promoteMutex_);
+        CacheKeyEqual<Key> equal;
+        for (Replica& replica : replicas_) {
+            std::lock_guard<std::mutex> replicaLock(replica.mutex);
+            auto& entries = replica.entries;
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [&](const Entry& entry) {
+                                             return entry.hash == hash &&
+                                                    equal(entry.key, key);
+                                         }),
+                          entries.end());
+        }
+        // 失效的键不再占用过滤位，之后的写入不必再锁住全部副本
+        filter_.store(filterOf(replicas_[0].entries));
+    }
+
+    // 汇总各分片的统计，选出估计占总读取比例不低于阈值的键（至多 maxKeys 个），
+    // 用 loader(key, hash, expireAt) 从分片取得句柄和过期时刻后发布到所有副本。
+    // 估计值偏高时至多多复制几个次热的键，不影响正确性。已有线程在刷新时直接返回
+    template <typename Loader>
+    void refresh(Loader&& loader) {
+        std::unique_lock<std::mutex> lock(promoteMutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return;
+        }
+        std::vector<Candidate> candidates;
+        uint64_t total = 0;
+        for (Sketch& sketch : sketches_) {
+            std::lock_guard<std::mutex> sketchLock(sketch.mutex);
+            total += sketch.counter.total();
+            for (const auto& counter : sketch.counter.counters()) {
+                candidates.push_back(
+                    Candidate{counter.key, counter.hash, counter.count});
+            }
+        }
+        if (total >= kHotKeyDecaySamples) {
+            // 样本足够多后整体减半，热点集合跟随访问模式变化
+            for (Sketch& sketch : sketches_) {
+                std::lock_guard<std::mutex> sketchLock(sketch.mutex);
+                sketch.counter.decay();
+            }
+        }
+        uint64_t threshold = static_cast<uint64_t>(minShare_ * total);
+        candidates.erase(
+            std::remove_if(candidates.begin(), candidates.end(),
+                           [&](const Candidate& c) {
+                               return total < kHotKeyMinSamples ||
+                                      c.count == 0 || c.count < threshold;
+                           }),
+            candidates.end());
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) {
+                      return a.count > b.count;
+                  });
+        if (candidates.size() > maxKeys_) {
+            candidates.resize(maxKeys_);
+        }
+
+        // 先登记新热点键的过滤位再读取分片：读取之后发生的写入一定会看到
+        // 过滤位，等待本次刷新完成后再移除副本中的条目
+        uint64_t bits = 0;
+        for (const Candidate& candidate : candidates) {
+            bits |= filterBit(candidate.hash);
+        }
+        filter_.fetch_or(bits);
+        std::vector<Entry> entries;
+        for (const Candidate& candidate : candidates) {
+            uint64_t expireAt = 0;
+            Handle handle = loader(candidate.key, candidate.hash, expireAt);
+            if (handle) {
+                entries.push_back(Entry{
+                    candidate.key, candidate.hash, expireAt,
+                    std::make_shared<const Handle>(std::move(handle))});
+            }
+        }
+        for (Replica& replica : replicas_) {
+            std::lock_guard<std::mutex> replicaLock(replica.mutex);
+            replica.entries = entries;
+        }
+        filter_.store(filterOf(entries));
+    }
+
+    // 当前被复制的热点键
+    std::vector<Key> keys() {
+        std::lock_guard<std::mutex> lock(promoteMutex_);
+        std::vector<Key> result;
+        for (const Entry& entry : replicas_[0].entries) {
+            result.push_back(entry.key);
+        }
+        return result;
+    }
+
+    // 副本命中次数
+    CacheStats stats() const { return stats_.snapshot(); }
+
+    void resetStats() { stats_.reset(); }
+
+   private:
+    struct Sketch {
+        explicit Sketch(size_t capacity) : counter(capacity) {}
+
+        std::mutex mutex;
+        SpaceSaving<Key> counter;
+    };
+
+    struct Entry {
+        Key key;
+        uint64_t hash;
+        uint64_t expireAt;  // 过期时刻（毫秒），0 表示不过期
+        std::shared_ptr<const Handle> handle;  // 各副本共享同一个句柄
+    };
+
+    struct Replica {
+        std::mutex mutex;
+        std::vector<Entry> entries;
+        std::atomic<uint32_t> reads{0};    // 映射到本副本的线程的读取次数
+        std::atomic<uint32_t> samples{0};  // 其中被采样的次数
+    };
+
+    struct Candidate {
+        Key key;
+        uint64_t hash;
+        uint64_t count;  // 出现次数的估计
+    };
+
+    // 64 位过滤器中的一位：取混淆后哈希的第 26~31 位，
+    // 与分片选择所用的高 32 位不重叠
+    static uint64_t filterBit(uint64_t hash) {
+        return 1ULL << ((hash >> 26) & 63);
+    }
+
+    static uint64_t filterOf(const std::vector<Entry>& entries) {
+        uint64_t bits = 0;
+        for (const Entry& entry : entries) {
+            bits |= filterBit(entry.hash);
+        }
+        return bits;
+    }
+
+    // 线程固定使用一条副本，线程数不超过副本数时各线程互不争用；
+    // 线程编号在所有实例间共享，只用于分条
+    size_t replicaIndex() const {
+        static std::atomic<size_t> nextThreadId{0};
+        thread_local size_t threadId = nextThreadId.fetch_add(1);
+        return threadId & (replicas_.size() - 1);
+    }
+
+   private:
+    size_t maxKeys_;
+    double minShare_;
+    ShardArray<Sketch> sketches_;   // 各分片的热点统计
+    ShardArray<Replica> replicas_;  // 按线程分条的副本，内容相同
+    std::atomic<uint64_t> filter_;  // 副本中的键占用的过滤位，读者先查过滤位
+    std::mutex promoteMutex_;       // 串行化刷新和失效
+    StatsRecorder stats_;           // 副本命中次数
+};
+}  // namespace IncreCache
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace IncreCache {
+// 对数-线性分桶（HdrHistogram 风格）：每个 2 的幂区间再均分为 kSubBucketCount 格，
+// 相对误差不超过 1/kSubBucketCount，桶数量只与可表示的最大值有关
+struct LatencyBuckets {
+    static constexpr int kSubBucketBits = 5;
+    static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+    static constexpr int kMaxValueBits = 40;  // 最大约 1100 秒（纳秒）
+    static constexpr size_t kBucketCount =
+        (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    static size_t indexOf(uint64_t value) {
+        if (value < kSubBucketCount) {
+            return static_cast<size_t>(value);
+        }
+        value = std::min<uint64_t>(value, (1ULL << kMaxValueBits) - 1);
+        int exponent = 63 - __builtin_clzll(value);
+        int shift = exponent - kSubBucketBits;
+        return static_cast<size_t>((shift + 1) * kSubBucketCount +
+                                   ((value >> shift) - kSubBucketCount));
+    }
+
+    // 第 index 格的下界
+    static uint64_t lowerBoundOf(size_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        int shift = static_cast<int>(index / kSubBucketCount) - 1;
+        uint64_t sub = index % kSubBucketCount + kSubBucketCount;
+        return sub << shift;
+    }
+};
+
+// 直方图快照：普通计数，可以合并并计算分位数
+class HistogramSnapshot {
+   public:
+    HistogramSnapshot() : counts_(LatencyBuckets::kBucketCount, 0) {}
+
+    HistogramSnapshot& operator+=(const HistogramSnapshot& other) {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        return *this;
+    }
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (uint64_t count : counts_) {
+            total += count;
+        }
+        return total;
+    }
+
+    // 分位数（ratio 取 0 ~ 1），返回所在格的下界，单位纳秒
+    uint64_t percentile(double ratio) const {
+        uint64_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(ratio * (total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return LatencyBuckets::lowerBoundOf(i);
+            }
+        }
+        return LatencyBuckets::lowerBoundOf(counts_.size() - 1);
+    }
+
+    double mean() const {
+        uint64_t total = 0;
+        double sum = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            total += counts_[i];
+            sum += static_cast<double>(counts_[i]) *
+                   LatencyBuckets::lowerBoundOf(i);
+        }
+        return total ? sum / total : 0.0;
+    }
+
+   private:
+    friend class LatencyHistogram;
+
+    std::vector<uint64_t> counts_;
+};
+
+// 无锁直方图：记录只是一次 relaxed 原子加，快照期间写入照常进行
+class LatencyHistogram {
+   public:
+    LatencyHistogram()
+        : counts_(new std::atomic<uint64_t>[LatencyBuckets::kBucketCount]) {
+        reset();
+    }
+
+    void record(uint64_t nanos) {
+        counts_[LatencyBuckets::indexOf(nanos)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot result;
+        for (size_t i = 0; i < LatencyBuckets::kBucketCount; ++i) {
+            result.counts_[i] = counts_[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < LatencyBuckets::kBucketCount; ++i) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+   private:
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+};
+
+// 一类操作的延迟快照：等锁时间与持锁（临界区）时间分开统计
+struct LatencySnapshot {
+    HistogramSnapshot wait;
+    HistogramSnapshot hold;
+
+    LatencySnapshot& operator+=(const LatencySnapshot& other) {
+        wait += other.wait;
+        hold += other.hold;
+        return *this;
+    }
+};
+
+// 一个缓存（或分片）的 get/put 延迟快照
+struct CacheLatencySnapshot {
+    LatencySnapshot get;
+    LatencySnapshot put;
+
+    CacheLatencySnapshot& operator+=(const CacheLatencySnapshot& other) {
+        get += other.get;
+        put += other.put;
+        return *this;
+    }
+};
+
+#ifdef INCRECACHE_LATENCY_HISTOGRAMS
+// 一类操作的等锁/持锁直方图
+struct LockLatency {
+    LatencyHistogram wait;
+    LatencyHistogram hold;
+
+    LatencySnapshot snapshot() const {
+        return LatencySnapshot{wait.snapshot(), hold.snapshot()};
+    }
+
+    void reset() {
+        wait.reset();
+        hold.reset();
+    }
+};
+
+// 加锁时记录等锁时间，解锁后记录持锁时间；直方图写入都在锁外完成
+template <typename Mutex>
+class TimedLockGuard {
+   public:
+    TimedLockGuard(Mutex& mutex, LockLatency& latency)
+        : mutex_(mutex), latency_(latency) {
+        auto begin = Clock::now();
+        mutex_.lock();
+        acquired_ = Clock::now();
+        latency_.wait.record(nanosBetween(begin, acquired_));
+    }
+
+    ~TimedLockGuard() {
+        auto released = Clock::now();
+        mutex_.unlock();
+        latency_.hold.record(nanosBetween(acquired_, released));
+    }
+
+    TimedLockGuard(const TimedLockGuard&) = delete;
+    TimedLockGuard& operator=(const TimedLockGuard&) = delete;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    static uint64_t nanosBetween(Clock::time_point begin,
+                                 Clock::time_point end) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+                .count());
+    }
+
+    Mutex& mutex_;
+    LockLatency& latency_;
+    Clock::time_point acquired_;
+};
+#else
+// 未开启延迟统计：空结构体，TimedLockGuard 退化为 std::lock_guard
+struct LockLatency {
+    LatencySnapshot snapshot() const { return LatencySnapshot(); }
+
+    void reset() {}
+};
+
+template <typename Mutex>
+class TimedLockGuard : public std::lock_guard<Mutex> {
+   public:
+    TimedLockGuard(Mutex& mutex, LockLatency&)
+        : std::lock_guard<Mutex>(mutex) {}
+};
+#endif
+
+// 一个缓存（或分片）的 get/put 延迟记录
+struct CacheLatency {
+    LockLatency get;
+    LockLatency put;
+
+    CacheLatencySnapshot snapshot() const {
+        return CacheLatencySnapshot{get.snapshot(), put.snapshot()};
+    }
+
+    void reset() {
+        get.reset();
+        put.reset();
+    }
+};
+}  // namespace IncreCache
@@ -1,13 +1,26 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "ICacheBatch.h"
+#include "ICacheKey.h"
 #include "ICachePolicy.h"
+#include "ICacheStats.h"
+#include "ICacheWeigher.h"
+#include "IHashMix.h"
+#include "ILatencyHistogram.h"
+#include "IShardArray.h"
+#include "ITimingWheel.h"
 
 namespace IncreCache {
 template <typename Key, typename Value>
@@ -17,23 +30,36 @@ template <typename Key, typename Value>
 class FreqList {
    private:
     struct Node {
-        int freq;  // 访问频次
+        int64_t freq;  // 访问频次（叠加了全局衰减偏移量）
         Key key;
         Value value;
+        size_t weight;  // 计入容量的权重
         std::weak_ptr<Node> pre;  // 上一结点改为 weak_ptr 打破循环引用
         std::shared_ptr<Node> next;
-        Node() : freq(1), next(nullptr) {}
-        Node(Key key, Value value)
-            : freq(1), key(key), value(value), next(nullptr) {}
+        TimerLink<Node> timer;  // 过期定时器
+        Node() : freq(1), weight(0), next(nullptr) { timer.owner = this; }
+        // value 由参数原地构造
+        template <typename... Args>
+        Node(const Key& key, Args&&... args)
+            : freq(1),
+              key(key),
+              value(std::forward<Args>(args)...),
+              weight(0),
+              next(nullptr) {
+            timer.owner = this;
+        }
     };
 
     using NodePtr = std::shared_ptr<Node>;
-    int freq_;      // 访问频率
+    int64_t freq_;  // 访问频率
     NodePtr head_;  // 假头结点
     NodePtr tail_;  // 假尾结点
+    FreqList* lower_;   // 频次更低的相邻链表
+    FreqList* higher_;  // 频次更高的相邻链表
 
    public:
-    explicit FreqList(int n) : freq_(n) {
+    explicit FreqList(int64_t n)
+        : freq_(n), lower_(nullptr), higher_(nullptr) {
         head_ = std::make_shared<Node>();
         tail_ = std::make_shared<Node>();
         head_->next = tail_;
@@ -72,81 +98,299 @@ class FreqList {
 };
 
 template <typename Key, typename Value>
-class ILfuCache : public ICachePolicy<Key, Value> {
+class ILfuCache
+    : public ICachePolicyAdapter<ILfuCache<Key, Value>, Key, Value> {
    public:
     using Node = typename FreqList<Key, Value>::Node;
     using NodePtr = std::shared_ptr<Node>;
-    using NodeMap = std::unordered_map<Key, NodePtr>;
-
-    ILfuCache(int capacity, int maxAverageNum = 1000000)
-        : capacity_(capacity),
+    using NodeMap = IndexMap<Key, NodePtr>;
+    using Weigher = CacheWeigher<Key, Value>;
+
+    // 按条目数限制容量；defaultTtl 为不指定存活时间的写入所用的默认值，
+    // 0 表示不过期
+    ILfuCache(
+        int capacity, int maxAverageNum = 1000000,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : maxAverageNum_(maxAverageNum),
+          defaultTtl_(defaultTtl),
+          maxWeight_(capacity > 0 ? capacity : 0),
+          weight_(0),
           minFreq_(INT8_MAX),
+          freqOffset_(0),
+          curAverageNum_(0),
+          curTotalNum_(0),
+          lowestFreqList_(nullptr) {}
+
+    // 按字节预算限制容量：条目权重为 weigher 的结果加上结点和索引的开销，
+    // 写入时淘汰访问频次最低的条目，直到总权重不超过 maxWeight；
+    // 单个条目的权重超过整个预算时不缓存
+    ILfuCache(
+        size_t maxWeight, Weigher weigher, int maxAverageNum = 1000000,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : weigher_(std::move(weigher), entryOverhead()),
           maxAverageNum_(maxAverageNum),
+          defaultTtl_(defaultTtl),
+          maxWeight_(maxWeight),
+          weight_(0),
+          minFreq_(INT8_MAX),
+          freqOffset_(0),
           curAverageNum_(0),
-          curTotalNum_(0) {}
+          curTotalNum_(0),
+          lowestFreqList_(nullptr) {}
 
     ~ILfuCache() override = default;
 
-    void put(Key key, Value value) override {
-        if (capacity_ == 0) {
+    // 插入或更新，右值 value 直接移动到结点中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        insertOrAssign(key, std::forward<V>(value), defaultTtl_);
+    }
+
+    // 插入或更新并指定存活时间，ttl 为 0 表示不过期；更新会重新开始计时
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value,
+                        std::chrono::milliseconds ttl) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.put);
+        maintain();
+        // 容量可能被 setCapacity 调整，需持锁读取
+        if (maxWeight_ == 0) {
             return;
         }
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = nodeMap_.find(key);
-        if (it != nodeMap_.end()) {
-            // 重置其 value 值
-            it->second->value = value;
-            // 找到了直接调整就好了，不用再去 get 找一遍，但其实影响不大
-            getInternal(it->second, value);
-            return;
+        assign(nodeMap_.find(key), key, std::forward<V>(value), ttl);
+    }
+
+    // 键不存在时用 args 在结点中原地构造 value，返回是否插入；
+    // 键已存在时不做任何修改
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.put);
+        maintain();
+        if (maxWeight_ == 0) {
+            return false;
+        }
+        if (nodeMap_.find(key) != nodeMap_.end()) {
+            return false;
         }
-        putInternal(key, value);
+        Node* node = putInternal(key, std::forward<Args>(args)...);
+        if (node == nullptr) {
+            return false;
+        }
+        scheduleExpiry(node, defaultTtl_);
+        stats_.record(StatCounter::Puts);
+        return true;
     }
 
     // value 值为传出参数
-    bool get(Key key, Value& value) override {
-        std::lock_guard<std::mutex> lock(mutex_);
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.get);
+        maintain();
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end()) {
             getInternal(it->second, value);
+            stats_.record(StatCounter::Hits);
             return true;
         }
+        stats_.record(StatCounter::Misses);
         return false;
     }
 
-    Value get(Key key) override {
-        Value value;
-        get(key, value);
-        return value;
+    // 读取 value，不增加访问频次，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maintain();
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            return false;
+        }
+        value = it->second->value;
+        return true;
+    }
+
+    // 批量读取 keys 中下标在 indices 里的键（供分片版本使用），整批只加锁一次。
+    // hashes[i] 为 keys[i] 的 CacheHash 结果；命中时写入 values[i] 并把
+    // found[i] 置为 true，返回命中数。先流水线预取并探测索引、预取命中的结点，
+    // 再统一调整频次链表和复制 value
+    size_t tryGetBatch(std::span<const Key> keys,
+                       std::span<const size_t> hashes,
+                       std::span<const uint32_t> indices,
+                       std::span<Value> values, std::span<bool> found) {
+        std::vector<NodePtr*> hits(indices.size());
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.get);
+        maintain();
+        for (size_t j = 0; j < indices.size(); ++j) {
+            indexPrefetch(nodeMap_, hashes, indices, j);
+            uint32_t i = indices[j];
+            auto it = indexFind(nodeMap_, keys[i], hashes[i]);
+            hits[j] = nullptr;
+            if (it != nodeMap_.end()) {
+                hits[j] = &it->second;
+                __builtin_prefetch(it->second.get());
+            }
+        }
+        // 读取不会增删索引中的条目，探测阶段记下的槽位依然有效
+        size_t hitCount = 0;
+        for (size_t j = 0; j < indices.size(); ++j) {
+            uint32_t i = indices[j];
+            found[i] = hits[j] != nullptr;
+            if (!found[i]) {
+                stats_.record(StatCounter::Misses);
+                continue;
+            }
+            getInternal(*hits[j], values[i]);
+            stats_.record(StatCounter::Hits);
+            ++hitCount;
+        }
+        return hitCount;
+    }
+
+    // 批量写入 keys 中下标在 indices 里的键（供分片版本使用），
+    // 整批只加锁一次，存活时间取默认值
+    void insertOrAssignBatch(std::span<const Key> keys,
+                             std::span<const size_t> hashes,
+                             std::span<const uint32_t> indices,
+                             std::span<const Value> values) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.put);
+        maintain();
+        if (maxWeight_ == 0) {
+            return;
+        }
+        for (size_t j = 0; j < indices.size(); ++j) {
+            indexPrefetch(nodeMap_, hashes, indices, j);
+            uint32_t i = indices[j];
+            assign(indexFind(nodeMap_, keys[i], hashes[i]), keys[i],
+                   values[i], defaultTtl_);
+        }
     }
 
     // 清空缓存，回收资源
     void purge() {
+        std::lock_guard<std::mutex> lock(mutex_);
         nodeMap_.clear();
         freqToFreqList_.clear();
+        timers_.reset();
+        weight_ = 0;
+        lowestFreqList_ = nullptr;
+        minFreq_ = INT8_MAX;
+        freqOffset_ = 0;
+        curAverageNum_ = 0;
+        curTotalNum_ = 0;
+    }
+
+    // 回收所有已到期的条目，返回回收数量。
+    // 读写操作本身也会顺带推进时间轮，长时间空闲的缓存可由维护线程定期调用
+    size_t purgeExpired() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return expireEntries();
     }
 
+    // 在线调整容量（条目数或字节预算，与构造方式一致），见 kResizeEvictionStep
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxWeight_ = capacity;
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return maxWeight_;
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = nodeMap_.size();
+        result.weight = weight_;
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // get/put 的等锁与持锁延迟快照（需定义 INCRECACHE_LATENCY_HISTOGRAMS）
+    CacheLatencySnapshot latency() const { return latency_.snapshot(); }
+
+    void resetLatency() { latency_.reset(); }
+
    private:
-    void putInternal(Key key, Value value);        // 添加缓存
+    static constexpr size_t entryOverhead() {
+        return sharedEntryBytes<Key, Node>();
+    }
+
+    // 插入或更新（持锁调用），it 为 key 在索引中的查找结果
+    template <typename V>
+    void assign(typename NodeMap::iterator it, const Key& key, V&& value,
+                std::chrono::milliseconds ttl) {
+        if (it != nodeMap_.end()) {
+            size_t limit = std::max(maxWeight_, weight_);
+            // 重置其 value 值
+            it->second->value = std::forward<V>(value);
+            // 找到了直接调整就好了，不用再去 get 找一遍，但其实影响不大
+            touchNode(it->second);
+            if (reweighNode(it->second.get()) > maxWeight_) {
+                // 更新后超出整个预算，不再缓存该键
+                removeEntry(it);
+                stats_.record(StatCounter::Rejections);
+                return;
+            }
+            scheduleExpiry(it->second.get(), ttl);
+            evictUntilFits(0, limit);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        Node* node = putInternal(key, std::forward<V>(value));
+        if (node == nullptr) {
+            return;
+        }
+        scheduleExpiry(node, ttl);
+        stats_.record(StatCounter::Puts);
+    }
+
+    template <typename... Args>
+    Node* putInternal(const Key& key, Args&&... args);  // 添加缓存
     void getInternal(NodePtr node, Value& value);  // 获取缓存
+    void touchNode(const NodePtr& node);           // 访问频次 +1
     void kickOut();                                // 移除缓存中的过期数据
+    void evictUntilFits(size_t incoming, size_t limit);  // 淘汰到能放下 incoming
+    void maintain();    // 读写开始时回收到期条目、分批淘汰缩容后的超额条目
+    void shrinkStep();  // 缩容后淘汰至多 kResizeEvictionStep 个超额条目
+    size_t reweighNode(Node* node);        // 重新计算结点权重
+    void removeEntry(typename NodeMap::iterator it);  // 删除一个结点
     void removeFromFreqList(NodePtr node);         // 从频率列表中移除结点
-    void addToFreqList(NodePtr node);              // 添加到频率列表
+    // 添加到频率列表，链表不存在时创建并接在 lower 之后（nullptr 表示最前）
+    void addToFreqList(NodePtr node, FreqList<Key, Value>* lower);
+    void eraseFreqList(int64_t freq);  // 回收空链表并维护最小频次
     void addFreqNum();                             // 增加平均访问等频率
-    void decreaseFreqNum(int num);                 // 减少平均访问等频率
+    void decreaseFreqNum(int64_t num);             // 减少平均访问等频率
     void handleOverMaxAverageNum();  // 处理当前平均访问频率超过上限的情况
-    void updateMinFreq();
+    size_t expireEntries();                        // 推进时间轮，回收到期结点
+    void expireNode(Node* node);                   // 删除一个到期结点
+    void scheduleExpiry(Node* node, std::chrono::milliseconds ttl);
+    void cancelExpiry(Node* node);
 
    private:
-    int capacity_;       // 缓存容量
-    int minFreq_;        // 最小访问频次（用于找到最小访问频次结点）
-    int maxAverageNum_;  // 最大平均访问频次
-    int curAverageNum_;  // 当前平均访问频次
-    int curTotalNum_;    // 当前访问所有缓存次数总数
-    std::mutex mutex_;   // 互斥锁
+    // 构造后不再修改的配置
+    EntryWeigher<Key, Value> weigher_;  // 条目权重，默认每个条目计 1
+    int maxAverageNum_;                 // 最大平均访问频次
+    std::chrono::milliseconds defaultTtl_;  // 默认存活时间，0 表示不过期
+    StatsRecorder stats_;   // 命中、淘汰等统计计数
+    CacheLatency latency_;  // get/put 延迟直方图
+    // 锁独占一个缓存行，等锁线程读写锁字时不会与持锁线程争抢下面的热数据
+    alignas(kCacheLineSize) std::mutex mutex_;
+    // 受锁保护、每次读写都会访问的数据，从下一个缓存行开始
+    alignas(kCacheLineSize) size_t maxWeight_;  // 容量（条目数或字节数）
+    size_t weight_;       // 当前总权重
+    int64_t minFreq_;     // 最小访问频次（用于找到最小访问频次结点）
+    int64_t freqOffset_;  // 全局衰减偏移量，结点实际频次为 freq - freqOffset_
+    int curAverageNum_;   // 当前平均访问频次
+    int64_t curTotalNum_;  // 当前访问所有缓存次数总数
     NodeMap nodeMap_;    // key 到缓存结点的映射
-    std::unordered_map<int, FreqList<Key, Value>*>
-        freqToFreqList_;  // 访问频次到该频次链表的映射
+    std::unordered_map<int64_t, std::unique_ptr<FreqList<Key, Value>>>
+        freqToFreqList_;  // 访问频次到该频次链表的映射（空链表会被及时回收）
+    // 现存的频次链表按频次升序串成双向链表，头部即最小频次链表
+    FreqList<Key, Value>* lowestFreqList_;
+    std::unique_ptr<TimingWheel<Node>> timers_;  // 过期时间轮，按需创建
 };
 
 template <typename Key, typename Value>
@@ -154,42 +398,105 @@ void ILfuCache<Key, Value>::getInternal(NodePtr node, Value& value) {
     // 找到之后需要将其从低访问频次的链表删除，并且添加到 +1 的访问频次链表中
     // 访问频次 +1，然后把 value 值返回
     value = node->value;
-    // 从原有访问频次的链表中删除结点
-    removeFromFreqList(node);
+    touchNode(node);
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::touchNode(const NodePtr& node) {
+    // 从原有访问频次的链表中删除结点，freq + 1 的链表若不存在就紧接在
+    // 原链表之后创建，之后原链表为空再回收，频次链表的顺序始终有序
+    FreqList<Key, Value>* oldList = freqToFreqList_[node->freq].get();
+    oldList->removeNode(node);
     node->freq++;
-    addToFreqList(node);
-    // 如果当前 node 的访问频次等于 minFreq + 1，并且其前驱链表为空，则说明
-    // freqToFreqList_[node->freq + 1] 链表因 node
-    // 的迁移已经空了，需要更新最小访问频次
-    if (node->freq - 1 == minFreq_ &&
-        freqToFreqList_[node->freq - 1]->isEmpty()) {
-        minFreq_++;
+    addToFreqList(node, oldList);
+    if (oldList->isEmpty()) {
+        eraseFreqList(oldList->freq_);
     }
     // 总访问频次和当前访问频次都随之增加
     addFreqNum();
 }
 
 template <typename Key, typename Value>
-void ILfuCache<Key, Value>::putInternal(Key key, Value value) {
-    // 如果不在缓存中，则需要判断缓存是否已满
-    if (nodeMap_.size() == capacity_) {
-        // 缓存已满，删除最不常访问的结点，更新当前平均访问频次和总访问频次
-        kickOut();
+template <typename... Args>
+typename ILfuCache<Key, Value>::Node* ILfuCache<Key, Value>::putInternal(
+    const Key& key, Args&&... args) {
+    NodePtr node = std::make_shared<Node>(key, std::forward<Args>(args)...);
+    node->weight = weigher_(node->key, node->value);
+    if (node->weight > maxWeight_) {
+        stats_.record(StatCounter::Rejections);
+        return nullptr;
+    }
+    // 缓存已满时删除最不常访问的结点，更新当前平均访问频次和总访问频次；
+    // 按条目数计时每个条目权重为 1，恰好淘汰一个
+    evictUntilFits(node->weight, std::max(maxWeight_, weight_));
+    // 新结点的实际频次为 1，但不能排在衰减后仍低于 1 的老结点之后，
+    // 因此取 freqOffset_ + 1 与当前最小频次中的较小者，最小频次链表依然非空
+    int64_t freq = freqOffset_ + 1;
+    if (!nodeMap_.empty()) {
+        freq = std::min(freq, minFreq_);
     }
-    // 创建新结点，将新结点添加进入，更新最小访问频次
-    NodePtr node = std::make_shared<Node>(key, value);
+    // 将新结点添加进入，更新最小访问频次
+    node->freq = freq;
     nodeMap_[key] = node;
-    addToFreqList(node);
+    weight_ += node->weight;
+    // freq 不大于现存的最小频次，对应链表不存在时放在最前
+    addToFreqList(node, nullptr);
     addFreqNum();
-    minFreq_ = std::min(minFreq_, 1);
+    return node.get();
 }
 
 template <typename Key, typename Value>
 void ILfuCache<Key, Value>::kickOut() {
-    NodePtr node = freqToFreqList_[minFreq_]->getFirstNode();
+    NodePtr node = lowestFreqList_->getFirstNode();
+    cancelExpiry(node.get());
     removeFromFreqList(node);
+    weight_ -= node->weight;
     nodeMap_.erase(node->key);
-    decreaseFreqNum(node->freq);
+    decreaseFreqNum(std::max<int64_t>(node->freq - freqOffset_, 1));
+    stats_.record(StatCounter::Evictions);
+}
+
+// limit 取容量与操作前总权重中的较大者：缩容后超额条目尚未淘汰完时，
+// 只保证本次写入不增加超额部分，超额部分交给 shrinkStep 分批淘汰
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::evictUntilFits(size_t incoming, size_t limit) {
+    while (weight_ + incoming > limit) {
+        kickOut();
+    }
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::maintain() {
+    expireEntries();
+    shrinkStep();
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::shrinkStep() {
+    if (weight_ <= maxWeight_) {
+        return;
+    }
+    for (size_t n = 0; n < kResizeEvictionStep && weight_ > maxWeight_; ++n) {
+        kickOut();
+    }
+}
+
+template <typename Key, typename Value>
+size_t ILfuCache<Key, Value>::reweighNode(Node* node) {
+    size_t weight = weigher_(node->key, node->value);
+    weight_ = weight_ - node->weight + weight;
+    node->weight = weight;
+    return weight;
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::removeEntry(typename NodeMap::iterator it) {
+    NodePtr victim = it->second;
+    cancelExpiry(victim.get());
+    removeFromFreqList(victim);
+    weight_ -= victim->weight;
+    nodeMap_.erase(it);
+    decreaseFreqNum(std::max<int64_t>(victim->freq - freqOffset_, 1));
 }
 
 template <typename Key, typename Value>
@@ -198,23 +505,62 @@ void ILfuCache<Key, Value>::removeFromFreqList(NodePtr node) {
     if (!node) {
         return;
     }
-    auto freq = node->freq;
-    freqToFreqList_[freq]->removeNode(node);
+    auto it = freqToFreqList_.find(node->freq);
+    if (it == freqToFreqList_.end()) {
+        return;
+    }
+    it->second->removeNode(node);
+    // 频次链表为空时立即释放，避免频次不断增长导致链表对象堆积
+    if (it->second->isEmpty()) {
+        eraseFreqList(node->freq);
+    }
 }
 
 template <typename Key, typename Value>
-void ILfuCache<Key, Value>::addToFreqList(NodePtr node) {
+void ILfuCache<Key, Value>::addToFreqList(NodePtr node,
+                                          FreqList<Key, Value>* lower) {
     // 检查结点是否为空
     if (!node) {
         return;
     }
     // 添加进入相应的频次链表前需要判断该频次链表是否存在
-    auto freq = node->freq;
-    if (freqToFreqList_.find(node->freq) == freqToFreqList_.end()) {
-        // 不存在则创建
-        freqToFreqList_[node->freq] = new FreqList<Key, Value>(node->freq);
+    auto& freqList = freqToFreqList_[node->freq];
+    if (!freqList) {
+        // 不存在则创建，并按频次顺序接入有序链表
+        freqList = std::make_unique<FreqList<Key, Value>>(node->freq);
+        FreqList<Key, Value>* higher =
+            lower != nullptr ? lower->higher_ : lowestFreqList_;
+        freqList->lower_ = lower;
+        freqList->higher_ = higher;
+        if (higher != nullptr) {
+            higher->lower_ = freqList.get();
+        }
+        if (lower != nullptr) {
+            lower->higher_ = freqList.get();
+        } else {
+            lowestFreqList_ = freqList.get();
+            minFreq_ = node->freq;
+        }
+    }
+    freqList->addNode(node);
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::eraseFreqList(int64_t freq) {
+    auto it = freqToFreqList_.find(freq);
+    FreqList<Key, Value>* freqList = it->second.get();
+    // 从有序链表中摘除，被摘除的是最小频次链表时由其后继接替，O(1)
+    if (freqList->higher_ != nullptr) {
+        freqList->higher_->lower_ = freqList->lower_;
     }
-    freqToFreqList_[freq]->addNode(node);
+    if (freqList->lower_ != nullptr) {
+        freqList->lower_->higher_ = freqList->higher_;
+    } else {
+        lowestFreqList_ = freqList->higher_;
+        minFreq_ = lowestFreqList_ != nullptr ? lowestFreqList_->freq_
+                                              : INT8_MAX;
+    }
+    freqToFreqList_.erase(it);
 }
 
 template <typename Key, typename Value>
@@ -231,7 +577,7 @@ void ILfuCache<Key, Value>::addFreqNum() {
 }
 
 template <typename Key, typename Value>
-void ILfuCache<Key, Value>::decreaseFreqNum(int num) {
+void ILfuCache<Key, Value>::decreaseFreqNum(int64_t num) {
     // 减少平均访问频次和总访问频次
     curTotalNum_ -= num;
     if (nodeMap_.empty()) {
@@ -242,69 +588,119 @@ void ILfuCache<Key, Value>::decreaseFreqNum(int num) {
 }
 
 template <typename Key, typename Value>
-void ILfuCache<Key, Value>::handleOverMaxAverageNum() {
-    if (nodeMap_.empty()) {
+size_t ILfuCache<Key, Value>::expireEntries() {
+    // 从未设置过期时间的缓存不读取时钟
+    if (!timers_ || timers_->empty()) {
+        return 0;
+    }
+    return timers_->advance(steadyNowMillis(),
+                            [this](Node* node) { expireNode(node); });
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::expireNode(Node* node) {
+    removeEntry(nodeMap_.find(node->key));
+    stats_.record(StatCounter::Expirations);
+}
+
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::scheduleExpiry(Node* node,
+                                           std::chrono::milliseconds ttl) {
+    if (ttl.count() <= 0) {
+        cancelExpiry(node);
         return;
     }
-    for (auto it = nodeMap_.begin(); it != nodeMap_.end(); it++) {
-        // 检查结点是否为空
-        if (!it->second) {
-            continue;
-        }
-        NodePtr node = it->second;
-        // 先从当前频率列表中移除
-        removeFromFreqList(node);
-        // 减少频率
-        node->freq -= maxAverageNum_ / 2;
-        if (node->freq < 1) {
-            node->freq = 1;
-        }
-        // 添加到新的频率列表
-        addToFreqList(node);
+    if (!timers_) {
+        // 时间轮按需创建，不使用过期功能的缓存不占用这部分内存
+        timers_ = std::make_unique<TimingWheel<Node>>();
     }
-    // 更新最小频率
-    updateMinFreq();
+    timers_->schedule(&node->timer, steadyNowMillis() + ttl.count());
 }
 
 template <typename Key, typename Value>
-void ILfuCache<Key, Value>::updateMinFreq() {
-    minFreq_ = INT8_MAX;
-    for (const auto& pair : freqToFreqList_) {
-        if (pair.second && !pair.second->isEmpty()) {
-            minFreq_ = std::min(minFreq_, pair.first);
-        }
+void ILfuCache<Key, Value>::cancelExpiry(Node* node) {
+    if (timers_) {
+        timers_->cancel(&node->timer);
     }
-    if (minFreq_ == INT8_MAX) {
-        minFreq_ = 1;
+}
+
+// 不再遍历所有结点逐个降低频次，而是整体抬高衰减偏移量：
+// 所有结点的实际频次同时减少 maxAverageNum_ / 2，相对顺序保持不变，单次 O(1)
+// 与逐个衰减的区别是实际频次不再截断到 1，低频老结点仍排在新结点之前被淘汰
+template <typename Key, typename Value>
+void ILfuCache<Key, Value>::handleOverMaxAverageNum() {
+    if (nodeMap_.empty()) {
+        return;
     }
+    int64_t decay = maxAverageNum_ / 2;
+    freqOffset_ += decay;
+    // 同步扣减总访问频次，否则平均值一直超限，每次访问都会触发衰减
+    curTotalNum_ -= decay * static_cast<int64_t>(nodeMap_.size());
+    if (curTotalNum_ < static_cast<int64_t>(nodeMap_.size())) {
+        curTotalNum_ = nodeMap_.size();
+    }
+    curAverageNum_ = curTotalNum_ / nodeMap_.size();
 }
 
 // 并没有牺牲时间换空间，只是把原有的缓存大小进行了分片
 template <typename Key, typename Value>
 class KHashLfuCache {
    public:
-    KHashLfuCache(size_t capacity, int sliceNum, int maxAverageNum = 10)
-        : sliceNum_(sliceNum > 0 ? sliceNum
+    KHashLfuCache(
+        size_t capacity, int sliceNum, int maxAverageNum = 10,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : capacity_(capacity),
+          sliceNum_(sliceNum > 0 ? sliceNum
                                  : std::thread::hardware_concurrency()),
-          capacity_(capacity) {
-        size_t sliceSize = std::ceil(
-            capacity_ / static_cast<double>(sliceNum_));  // 每个 lfu 分片的容量
-        for (int i = 0; i < sliceNum_; i++) {
-            lfuSliceCaches_.emplace_back(
-                new ILfuCache<Key, Value>(sliceSize, maxAverageNum));
-        }
-    }
+          weighted_(false),
+          lfuSliceCaches_(sliceNum_, sliceCapacity(capacity_), maxAverageNum,
+                          defaultTtl) {}
+
+    // 按字节预算限制容量，每个分片得到总预算的 1/sliceNum
+    KHashLfuCache(
+        size_t maxWeight, int sliceNum,
+        typename ILfuCache<Key, Value>::Weigher weigher,
+        int maxAverageNum = 10,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : capacity_(maxWeight),
+          sliceNum_(sliceNum > 0 ? sliceNum
+                                 : std::thread::hardware_concurrency()),
+          weighted_(true),
+          lfuSliceCaches_(sliceNum_, sliceCapacity(capacity_), weigher,
+                          maxAverageNum, defaultTtl) {}
+
+    void put(Key key, Value value) { insertOrAssign(key, std::move(value)); }
 
-    void put(Key key, Value value) {
+    bool get(Key key, Value& value) { return tryGet(key, value); }
+
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
         // 根据 key 找出对应的 lfu 分片
-        size_t sliceIndex = Hash(key) % sliceNum_;
-        return lfuSliceCaches_[sliceIndex]->put(key, value);
+        size_t sliceIndex = sliceOf(key);
+        lfuSliceCaches_[sliceIndex].insertOrAssign(key,
+                                                   std::forward<V>(value));
+    }
+
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value,
+                        std::chrono::milliseconds ttl) {
+        size_t sliceIndex = sliceOf(key);
+        lfuSliceCaches_[sliceIndex].insertOrAssign(
+            key, std::forward<V>(value), ttl);
+    }
+
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        size_t sliceIndex = sliceOf(key);
+        return lfuSliceCaches_[sliceIndex].emplace(
+            key, std::forward<Args>(args)...);
     }
 
-    bool get(Key key, Value& value) {
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
         // 根据 key 找出对应的 lfu 分片
-        size_t sliceIndex = Hash(key) % sliceNum_;
-        return lfuSliceCaches_[sliceIndex]->get(key, value);
+        size_t sliceIndex = sliceOf(key);
+        return lfuSliceCaches_[sliceIndex].tryGet(key, value);
     }
 
     Value get(Key key) {
@@ -313,25 +709,144 @@ class KHashLfuCache {
         return value;
     }
 
+    // 由 key 所在分片合并并发加载，不同分片的加载互不阻塞
+    template <typename Loader>
+    Value getOrLoad(const Key& key, Loader&& loader) {
+        size_t sliceIndex = sliceOf(key);
+        return lfuSliceCaches_[sliceIndex].getOrLoad(
+            key, std::forward<Loader>(loader));
+    }
+
+    // 批量读取：先计算全部键的哈希并按分片分组，每个分片只加锁一次。
+    // 命中的 keys[i] 写入 values[i] 并把 found[i] 置为 true，返回命中数；
+    // values 和 found 的长度不小于 keys
+    size_t multiGet(std::span<const Key> keys, std::span<Value> values,
+                    std::span<bool> found) {
+        ShardBatch batch;
+        groupByShard(keys, sliceNum_, batch);
+        size_t hits = 0;
+        for (int i = 0; i < sliceNum_; i++) {
+            std::span<const uint32_t> indices = batch.shard(i);
+            if (!indices.empty()) {
+                hits += lfuSliceCaches_[i].tryGetBatch(keys, batch.hashes,
+                                                       indices, values, found);
+            }
+        }
+        return hits;
+    }
+
+    // 批量写入：keys[i] 对应 values[i]，按分片分组后每个分片只加锁一次
+    void multiPut(std::span<const Key> keys, std::span<const Value> values) {
+        ShardBatch batch;
+        groupByShard(keys, sliceNum_, batch);
+        for (int i = 0; i < sliceNum_; i++) {
+            std::span<const uint32_t> indices = batch.shard(i);
+            if (!indices.empty()) {
+                lfuSliceCaches_[i].insertOrAssignBatch(keys, batch.hashes,
+                                                       indices, values);
+            }
+        }
+    }
+
     // 清除缓存
     void purge() {
         for (auto& lfuSliceCache : lfuSliceCaches_) {
-            lfuSliceCache->purge();
+            lfuSliceCache.purge();
+        }
+    }
+
+    // 回收所有分片中已到期的条目
+    size_t purgeExpired() {
+        size_t expired = 0;
+        for (auto& lfuSliceCache : lfuSliceCaches_) {
+            expired += lfuSliceCache.purgeExpired();
+        }
+        return expired;
+    }
+
+    // 在线调整总容量，按与构造时相同的规则重新分配各分片的容量；
+    // 各分片依次加锁调整，缩容时超额条目由各分片分批淘汰
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(resizeMutex_);
+        capacity_ = capacity;
+        size_t sliceSize = sliceCapacity(capacity_);
+        for (auto& lfuSliceCache : lfuSliceCaches_) {
+            lfuSliceCache.setCapacity(sliceSize);
+        }
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(resizeMutex_);
+        return capacity_;
+    }
+
+    // 汇总所有分片的统计
+    CacheStats stats() {
+        CacheStats result;
+        for (auto& lfuSliceCache : lfuSliceCaches_) {
+            result += lfuSliceCache.stats();
+        }
+        return result;
+    }
+
+    void resetStats() {
+        for (auto& lfuSliceCache : lfuSliceCaches_) {
+            lfuSliceCache.resetStats();
+        }
+    }
+
+    // 各分片的延迟快照，可用于定位衰减或锁排队造成的长尾
+    std::vector<CacheLatencySnapshot> shardLatencies() const {
+        std::vector<CacheLatencySnapshot> result;
+        for (const auto& lfuSliceCache : lfuSliceCaches_) {
+            result.push_back(lfuSliceCache.latency());
+        }
+        return result;
+    }
+
+    // 合并所有分片的延迟快照
+    CacheLatencySnapshot latency() const {
+        CacheLatencySnapshot result;
+        for (const auto& lfuSliceCache : lfuSliceCaches_) {
+            result += lfuSliceCache.latency();
+        }
+        return result;
+    }
+
+    void resetLatency() {
+        for (auto& lfuSliceCache : lfuSliceCaches_) {
+            lfuSliceCache.resetLatency();
         }
     }
 
    private:
     // 将 key 计算成对应哈希值
-    size_t Hash(Key key) {
-        std::hash<Key> hashFunc;
+    template <typename K>
+    size_t Hash(const K& key) {
+        CacheHash<Key> hashFunc;
         return hashFunc(key);
     }
 
+    // 混淆 key 的哈希后取高位选择分片（见 shardOf）
+    template <typename K>
+    size_t sliceOf(const K& key) {
+        return shardOf(mixHash(Hash(key)), sliceNum_);
+    }
+
+    // 按条目数时向上取整；按字节预算时向下取整，各分片之和不超过总预算
+    size_t sliceCapacity(size_t capacity) const {
+        if (weighted_) {
+            return capacity / sliceNum_;
+        }
+        return std::ceil(capacity / static_cast<double>(sliceNum_));
+    }
+
    private:
-    size_t capacity_;  // 缓存总容量
+    size_t capacity_;  // 缓存总容量（条目数或字节数）
     int sliceNum_;     // 缓存分片数量
-    std::vector<std::unique_ptr<ILfuCache<Key, Value>>>
-        lfuSliceCaches_;  // 缓存 lfu 分片容器
+    bool weighted_;    // 是否按字节预算
+    std::mutex resizeMutex_;  // 串行化 setCapacity
+    ShardArray<ILfuCache<Key, Value>> lfuSliceCaches_;  // 缓存 lfu 分片容器
 };
 
 }  // namespace IncreCache
\ No newline at end of file
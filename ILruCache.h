@@ -1,32 +1,61 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "ICacheBatch.h"
+#include "ICacheKey.h"
 #include "ICachePolicy.h"
+#include "ICacheStats.h"
+#include "ICacheWeigher.h"
+#include "IHashMix.h"
+#include "IHotKeyReplicas.h"
+#include "ILatencyHistogram.h"
+#include "IShardArray.h"
+#include "ITimingWheel.h"
 
 namespace IncreCache {
 // 前向声明
 template <typename Key, typename Value>
 class ILruCache;
 
+template <typename Key, typename Value>
+class LruHandle;
+
 template <typename Key, typename Value>
 class LruNode {
    private:
     Key key_;
     Value value_;
     size_t accessCount_;                       // 访问次数
+    size_t weight_;                            // 计入容量的权重
+    std::atomic<size_t> pins_{0};              // 持有该结点的句柄数
+    std::atomic<bool> retired_{false};         // 已离开缓存
+    TimerLink<LruNode<Key, Value>> timer_;     // 过期定时器
     std::weak_ptr<LruNode<Key, Value>> prev_;  // 改为 weak_ptr 打破循环引用
     std::shared_ptr<LruNode<Key, Value>> next_;
 
    public:
-    LruNode(Key key, Value value) : key_(key), value_(value), accessCount_(1) {}
+    // value 由参数原地构造
+    template <typename... Args>
+    LruNode(const Key& key, Args&&... args)
+        : key_(key),
+          value_(std::forward<Args>(args)...),
+          accessCount_(1),
+          weight_(0) {
+        timer_.owner = this;
+    }
 
     // 提供必要的访问器
     Key getkey() const { return key_; }
@@ -40,64 +69,314 @@ class LruNode {
     void incrementAccessCount() { ++accessCount_; }
 
     friend class ILruCache<Key, Value>;
+    friend class LruHandle<Key, Value>;
 };
 
+// lookup 返回的只读句柄：持有结点的引用并把结点标记为被钉住，
+// 释放锁之后仍可原地读取 value，不需要拷贝。
+// 结点被淘汰或删除时只是从链表和哈希表中摘除，内存在最后一个句柄析构后才释放；
+// 被钉住的结点被更新时，缓存会换上新结点（写时复制），句柄看到的值保持不变
 template <typename Key, typename Value>
-class ILruCache : public ICachePolicy<Key, Value> {
+class LruHandle {
+   public:
+    LruHandle() = default;
+
+    LruHandle(LruHandle&& other) noexcept = default;
+
+    LruHandle& operator=(LruHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            node_ = std::move(other.node_);
+        }
+        return *this;
+    }
+
+    LruHandle(const LruHandle&) = delete;
+    LruHandle& operator=(const LruHandle&) = delete;
+
+    ~LruHandle() { reset(); }
+
+    explicit operator bool() const { return node_ != nullptr; }
+
+    const Key& key() const { return node_->key_; }
+
+    const Value& value() const { return node_->value_; }
+
+    const Value& operator*() const { return node_->value_; }
+
+    const Value* operator->() const { return &node_->value_; }
+
+    // 结点已离开缓存（被淘汰、到期、删除或被新值替换），
+    // 句柄中的 value 不再是缓存中的当前值
+    bool retired() const { return node_->retired_.load(); }
+
+    // 提前释放句柄
+    void reset() {
+        if (node_) {
+            // release：保证本句柄对 value 的读取先于之后的原地更新
+            node_->pins_.fetch_sub(1, std::memory_order_release);
+            node_.reset();
+        }
+    }
+
+   private:
+    friend class ILruCache<Key, Value>;
+
+    // 只由缓存在持锁时构造，保证写者在锁内看到的钉住计数是准确的
+    explicit LruHandle(std::shared_ptr<LruNode<Key, Value>> node)
+        : node_(std::move(node)) {
+        node_->pins_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<LruNode<Key, Value>> node_;
+};
+
+template <typename Key, typename Value>
+class ILruCache
+    : public ICachePolicyAdapter<ILruCache<Key, Value>, Key, Value> {
    public:
     using LruNodeType = LruNode<Key, Value>;
     using NodePtr = std::shared_ptr<LruNodeType>;
-    using NodeMap = std::unordered_map<Key, NodePtr>;
+    using NodeMap = IndexMap<Key, NodePtr>;
+    using Handle = LruHandle<Key, Value>;
+    using Weigher = CacheWeigher<Key, Value>;
+
+    // 按条目数限制容量；defaultTtl 为不指定存活时间的写入所用的默认值，
+    // 0 表示不过期
+    ILruCache(
+        int capacity,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : defaultTtl_(defaultTtl),
+          maxWeight_(capacity > 0 ? capacity : 0),
+          weight_(0) {
+        initializeList();
+    }
 
-    ILruCache(int capacity) : capacity_(capacity) { initializeList(); }
+    // 按字节预算限制容量：条目权重为 weigher 的结果加上结点和索引的开销，
+    // 写入时淘汰最久未访问的条目，直到总权重不超过 maxWeight；
+    // 单个条目的权重超过整个预算时不缓存
+    ILruCache(
+        size_t maxWeight, Weigher weigher,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : weigher_(std::move(weigher), entryOverhead()),
+          defaultTtl_(defaultTtl),
+          maxWeight_(maxWeight),
+          weight_(0) {
+        initializeList();
+    }
 
     ~ILruCache() override = default;
 
-    void put(Key key, Value value) override {
-        if (capacity_ <= 0) {
-            return;
-        }
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = nodeMap_.find(key);
-        if (it != nodeMap_.end()) {
-            // 如果在当前容器中，则更新 value，并调用 get
-            // 方法，代表该数据刚被访问过
-            updateExistingNode(it->second, value);
+    // 插入或更新，右值 value 直接移动到结点中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        insertOrAssign(key, std::forward<V>(value), defaultTtl_);
+    }
+
+    // 插入或更新并指定存活时间，ttl 为 0 表示不过期；更新会重新开始计时
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value,
+                        std::chrono::milliseconds ttl) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.put);
+        maintain();
+        // 容量可能被 setCapacity 调整，需持锁读取
+        if (maxWeight_ == 0) {
             return;
         }
-        addNewNode(key, value);
+        assign(nodeMap_.find(key), key, std::forward<V>(value), ttl);
     }
 
-    Value get(Key key) override {
-        Value value{};
-        // memset(&value, 0, sizeof(value)); // memset
-        // 是按字节设置内存的，对于复杂类型 （如 string） 使用 memset
-        // 可能会破坏对象的内部结构
-        get(key, value);
-        return value;
+    // 键不存在时用 args 在结点中原地构造 value，返回是否插入；
+    // 键已存在时不做任何修改
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.put);
+        maintain();
+        if (maxWeight_ == 0) {
+            return false;
+        }
+        if (nodeMap_.find(key) != nodeMap_.end()) {
+            return false;
+        }
+        LruNodeType* node = addNewNode(key, std::forward<Args>(args)...);
+        if (node == nullptr) {
+            return false;
+        }
+        scheduleExpiry(node, defaultTtl_);
+        stats_.record(StatCounter::Puts);
+        return true;
     }
 
-    bool get(Key key, Value& value) override {
-        std::lock_guard<std::mutex> lock(mutex_);
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.get);
+        maintain();
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end()) {
             moveToMostRecent(it->second);
-            value = it->second->getValue();
+            value = it->second->value_;
+            stats_.record(StatCounter::Hits);
             return true;
         }
+        stats_.record(StatCounter::Misses);
         return false;
     }
 
+    // 读取 value，不调整访问顺序，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maintain();
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            return false;
+        }
+        value = it->second->value_;
+        return true;
+    }
+
+    // 零拷贝读取：命中时返回钉住结点的句柄，调用方在锁外原地读取 value；
+    // 未命中时返回空句柄。锁内只做查找和链表调整，持锁时间与 value 大小无关
+    template <typename K>
+    Handle lookup(const K& key) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.get);
+        maintain();
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            stats_.record(StatCounter::Misses);
+            return Handle();
+        }
+        moveToMostRecent(it->second);
+        stats_.record(StatCounter::Hits);
+        return Handle(it->second);
+    }
+
+    // 批量读取 keys 中下标在 indices 里的键（供分片版本使用），整批只加锁一次。
+    // hashes[i] 为 keys[i] 的 CacheHash 结果；命中时写入 values[i] 并把
+    // found[i] 置为 true，返回命中数。先流水线预取并探测索引、预取命中的结点，
+    // 再统一调整链表和复制 value，结点的访存延迟在探测阶段就已重叠
+    size_t tryGetBatch(std::span<const Key> keys,
+                       std::span<const size_t> hashes,
+                       std::span<const uint32_t> indices,
+                       std::span<Value> values, std::span<bool> found) {
+        std::vector<NodePtr*> hits(indices.size());
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.get);
+        maintain();
+        for (size_t j = 0; j < indices.size(); ++j) {
+            indexPrefetch(nodeMap_, hashes, indices, j);
+            uint32_t i = indices[j];
+            auto it = indexFind(nodeMap_, keys[i], hashes[i]);
+            hits[j] = nullptr;
+            if (it != nodeMap_.end()) {
+                hits[j] = &it->second;
+                __builtin_prefetch(it->second.get());
+            }
+        }
+        // 读取不会增删索引中的条目，探测阶段记下的槽位依然有效
+        size_t hitCount = 0;
+        for (size_t j = 0; j < indices.size(); ++j) {
+            uint32_t i = indices[j];
+            found[i] = hits[j] != nullptr;
+            if (!found[i]) {
+                stats_.record(StatCounter::Misses);
+                continue;
+            }
+            moveToMostRecent(*hits[j]);
+            values[i] = (*hits[j])->value_;
+            stats_.record(StatCounter::Hits);
+            ++hitCount;
+        }
+        return hitCount;
+    }
+
+    // 批量写入 keys 中下标在 indices 里的键（供分片版本使用），
+    // 整批只加锁一次，存活时间取默认值
+    void insertOrAssignBatch(std::span<const Key> keys,
+                             std::span<const size_t> hashes,
+                             std::span<const uint32_t> indices,
+                             std::span<const Value> values) {
+        TimedLockGuard<std::mutex> lock(mutex_, latency_.put);
+        maintain();
+        if (maxWeight_ == 0) {
+            return;
+        }
+        for (size_t j = 0; j < indices.size(); ++j) {
+            indexPrefetch(nodeMap_, hashes, indices, j);
+            uint32_t i = indices[j];
+            assign(indexFind(nodeMap_, keys[i], hashes[i]), keys[i],
+                   values[i], defaultTtl_);
+        }
+    }
+
+    // 取 key 的句柄和过期时刻（毫秒，0 表示不过期），不调整访问顺序，
+    // 也不计入统计；供分片版本发布热点键副本时使用
+    template <typename K>
+    Handle pin(const K& key, uint64_t& expireAt) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maintain();
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            return Handle();
+        }
+        expireAt = it->second->timer_.expireAt;
+        return Handle(it->second);
+    }
+
     // 删除指定元素
-    void remove(Key key) {
+    template <typename K>
+    void remove(const K& key) {
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end()) {
-            removeNode(it->second);
-            nodeMap_.erase(it);
+            eraseEntry(it);
         }
     }
 
+    // 回收所有已到期的条目，返回回收数量。
+    // 读写操作本身也会顺带推进时间轮，长时间空闲的缓存可由维护线程定期调用
+    size_t purgeExpired() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return expireEntries();
+    }
+
+    // 在线调整容量（条目数或字节预算，与构造方式一致），见 kResizeEvictionStep
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxWeight_ = capacity;
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return maxWeight_;
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = nodeMap_.size();
+        result.weight = weight_;
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // get/put 的等锁与持锁延迟快照（需定义 INCRECACHE_LATENCY_HISTOGRAMS）
+    CacheLatencySnapshot latency() const { return latency_.snapshot(); }
+
+    void resetLatency() { latency_.reset(); }
+
+   protected:
+    // 只判断是否存在，不调整访问顺序，也不计入命中统计
+    template <typename K>
+    bool contains(const K& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return nodeMap_.find(key) != nodeMap_.end();
+    }
+
+    StatsRecorder stats_;  // 命中、淘汰等统计计数
+
    private:
     void initializeList() {
         // 创建首尾虚拟节点
@@ -107,20 +386,150 @@ class ILruCache : public ICachePolicy<Key, Value> {
         dummyTail_->prev_ = dummyHead_;
     }
 
-    void updateExistingNode(NodePtr node, const Value& value) {
-        node->setValue(value);
-        moveToMostRecent(node);
+    static constexpr size_t entryOverhead() {
+        return sharedEntryBytes<Key, LruNodeType>();
     }
 
-    void addNewNode(const Key& key, const Value& value) {
-        if (nodeMap_.size() >= capacity_) {
-            evictLeastRecent();
+    // 插入或更新（持锁调用），it 为 key 在索引中的查找结果
+    template <typename V>
+    void assign(typename NodeMap::iterator it, const Key& key, V&& value,
+                std::chrono::milliseconds ttl) {
+        if (it != nodeMap_.end()) {
+            size_t limit = std::max(maxWeight_, weight_);
+            // 如果在当前容器中，则更新 value，并调用 get
+            // 方法，代表该数据刚被访问过
+            updateExistingNode(it->second, std::forward<V>(value));
+            if (it->second->weight_ > maxWeight_) {
+                // 更新后超出整个预算，不再缓存该键
+                eraseEntry(it);
+                stats_.record(StatCounter::Rejections);
+                return;
+            }
+            scheduleExpiry(it->second.get(), ttl);
+            // 该结点已在最近端，权重变大时先淘汰的是其他结点
+            evictUntilFits(0, limit);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        LruNodeType* node = addNewNode(key, std::forward<V>(value));
+        if (node == nullptr) {
+            return;
+        }
+        scheduleExpiry(node, ttl);
+        stats_.record(StatCounter::Puts);
+    }
+
+    // 更新 value 并重新计算权重，不做淘汰
+    template <typename V>
+    void updateExistingNode(NodePtr& node, V&& value) {
+        size_t oldWeight = node->weight_;
+        // 新句柄只在持锁时产生，这里读到 0 说明此刻没有读者，可以原地更新
+        if (node->pins_.load(std::memory_order_acquire) == 0) {
+            node->value_ = std::forward<V>(value);
+            moveToMostRecent(node);
+        } else {
+            // 结点被句柄钉住：换上新结点，旧结点留给句柄持有者读取
+            NodePtr fresh = std::make_shared<LruNodeType>(
+                node->key_, std::forward<V>(value));
+            fresh->accessCount_ = node->accessCount_;
+            cancelExpiry(node.get());
+            removeNode(node);
+            retireNode(node.get());
+            insertNode(fresh);
+            node = std::move(fresh);
         }
-        NodePtr newNode = std::make_shared<LruNodeType>(key, value);
+        node->weight_ = weigher_(node->key_, node->value_);
+        weight_ = weight_ - oldWeight + node->weight_;
+    }
+
+    // 插入新结点，返回 nullptr 表示单个条目超出整个预算而未缓存
+    template <typename... Args>
+    LruNodeType* addNewNode(const Key& key, Args&&... args) {
+        NodePtr newNode =
+            std::make_shared<LruNodeType>(key, std::forward<Args>(args)...);
+        newNode->weight_ = weigher_(newNode->key_, newNode->value_);
+        if (newNode->weight_ > maxWeight_) {
+            stats_.record(StatCounter::Rejections);
+            return nullptr;
+        }
+        // 按条目数计时每个条目权重为 1，缓存满时恰好淘汰一个
+        evictUntilFits(newNode->weight_, std::max(maxWeight_, weight_));
         insertNode(newNode);
         nodeMap_[key] = newNode;
+        weight_ += newNode->weight_;
+        return newNode.get();
+    }
+
+    // 从最久未访问端淘汰，直到总权重加上 incoming 不超过 limit。
+    // limit 取容量与操作前总权重中的较大者：缩容后超额条目尚未淘汰完时，
+    // 只保证本次写入不增加超额部分，超额部分交给 shrinkStep 分批淘汰
+    void evictUntilFits(size_t incoming, size_t limit) {
+        while (weight_ + incoming > limit) {
+            evictLeastRecent();
+        }
+    }
+
+    // 每次读写开始时的维护：回收到期条目，缩容后分批淘汰超额条目
+    void maintain() {
+        expireEntries();
+        shrinkStep();
+    }
+
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep && weight_ > maxWeight_;
+             ++n) {
+            evictLeastRecent();
+        }
+    }
+
+    void eraseEntry(typename NodeMap::iterator it) {
+        cancelExpiry(it->second.get());
+        removeNode(it->second);
+        retireNode(it->second.get());
+        weight_ -= it->second->weight_;
+        nodeMap_.erase(it);
+    }
+
+    // 推进时间轮并回收到期条目；从未设置过期时间的缓存不读取时钟
+    size_t expireEntries() {
+        if (!timers_ || timers_->empty()) {
+            return 0;
+        }
+        return timers_->advance(
+            steadyNowMillis(), [this](LruNodeType* node) { expireNode(node); });
+    }
+
+    void expireNode(LruNodeType* node) {
+        auto it = nodeMap_.find(node->key_);
+        removeNode(it->second);
+        retireNode(node);
+        weight_ -= node->weight_;
+        nodeMap_.erase(it);
+        stats_.record(StatCounter::Expirations);
+    }
+
+    // ttl 大于 0 时登记（或改期）定时器，否则取消已有的定时器
+    void scheduleExpiry(LruNodeType* node, std::chrono::milliseconds ttl) {
+        if (ttl.count() <= 0) {
+            cancelExpiry(node);
+            return;
+        }
+        if (!timers_) {
+            // 时间轮按需创建，不使用过期功能的缓存不占用这部分内存
+            timers_ = std::make_unique<TimingWheel<LruNodeType>>();
+        }
+        timers_->schedule(&node->timer_, steadyNowMillis() + ttl.count());
     }
 
+    void cancelExpiry(LruNodeType* node) {
+        if (timers_) {
+            timers_->cancel(&node->timer_);
+        }
+    }
+
+    // 结点离开缓存时标记，仍持有其句柄的读者据此判断值已失效
+    static void retireNode(LruNodeType* node) { node->retired_.store(true); }
+
     // 将该节点移动到最新的位置
     void moveToMostRecent(NodePtr node) {
         removeNode(node);
@@ -147,14 +556,26 @@ class ILruCache : public ICachePolicy<Key, Value> {
     // 驱逐最近最少访问
     void evictLeastRecent() {
         NodePtr leastRecent = dummyHead_->next_;
+        cancelExpiry(leastRecent.get());
         removeNode(leastRecent);
+        retireNode(leastRecent.get());
+        weight_ -= leastRecent->weight_;
         nodeMap_.erase(leastRecent->getkey());
+        stats_.record(StatCounter::Evictions);
     }
 
    private:
-    int capacity_;     // 缓存容量
+    // 构造后不再修改的配置
+    EntryWeigher<Key, Value> weigher_;      // 条目权重，默认每个条目计 1
+    std::chrono::milliseconds defaultTtl_;  // 默认存活时间，0 表示不过期
+    CacheLatency latency_;  // get/put 延迟直方图
+    // 锁独占一个缓存行，等锁线程读写锁字时不会与持锁线程争抢下面的热数据
+    alignas(kCacheLineSize) std::mutex mutex_;
+    // 受锁保护、每次读写都会访问的数据，从下一个缓存行开始
+    alignas(kCacheLineSize) size_t maxWeight_;  // 容量（条目数或字节数）
+    size_t weight_;    // 当前总权重
     NodeMap nodeMap_;  // key -> value
-    std::mutex mutex_;
+    std::unique_ptr<TimingWheel<LruNodeType>> timers_;  // 过期时间轮
     NodePtr dummyHead_;  // 虚拟头结点
     NodePtr dummyTail_;
 };
@@ -196,6 +617,7 @@ class ILruKCache : public ILruCache<Key, Value> {
                 historyValueMap_.erase(it);
                 // 添加到主缓存
                 ILruCache<Key, Value>::put(key, storedValue);
+                this->stats_.record(StatCounter::Admissions);
                 return storedValue;
             }
             // 没有历史值记录，无法添加到缓存，返回默认值
@@ -205,9 +627,8 @@ class ILruKCache : public ILruCache<Key, Value> {
     }
 
     void put(Key key, Value value) {
-        // 检查是否已在主缓存
-        Value existingValue{};
-        bool inMainCache = ILruCache<Key, Value>::get(key, existingValue);
+        // 检查是否已在主缓存（不计入命中统计，更新时会移动到最近端）
+        bool inMainCache = this->contains(key);
         if (inMainCache) {
             // 已在主缓存，直接更新
             ILruCache<Key, Value>::put(key, value);
@@ -225,10 +646,24 @@ class ILruKCache : public ILruCache<Key, Value> {
             historyList_->remove(key);
             historyValueMap_.erase(key);
             ILruCache<Key, Value>::put(key, value);
+            this->stats_.record(StatCounter::Admissions);
+        } else {
+            // 访问次数不足，只记录在历史中
+            this->stats_.record(StatCounter::Rejections);
         }
     }
 
    private:
+    // LRU-K 的准入逻辑只实现在 put/get 中，屏蔽基类的非虚快速接口
+    using ILruCache<Key, Value>::insertOrAssign;
+    using ILruCache<Key, Value>::emplace;
+    using ILruCache<Key, Value>::tryGet;
+    using ILruCache<Key, Value>::lookup;
+    using ILruCache<Key, Value>::pin;
+    using ILruCache<Key, Value>::getOrLoad;
+    using ILruCache<Key, Value>::tryGetBatch;
+    using ILruCache<Key, Value>::insertOrAssignBatch;
+
     int k_;  // 进入缓存队列的评判标准
     std::unique_ptr<ILruCache<Key, size_t>>
         historyList_;  // 访问数据历史记录（value 为访问次数）
@@ -240,27 +675,96 @@ class ILruKCache : public ILruCache<Key, Value> {
 template <typename Key, typename Value>
 class IHashLruCaches {
    public:
-    IHashLruCaches(size_t capacity, int sliceNum)
+    IHashLruCaches(
+        size_t capacity, int sliceNum,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
         : capacity_(capacity),
           sliceNum_(sliceNum > 0 ? sliceNum
-                                 : std::thread::hardware_concurrency()) {
-        size_t sliceSize = std::ceil(
-            capacity_ / static_cast<double>(sliceNum_));  // 获取每个分片大小
-        for (int i = 0; i < sliceNum_; i++) {
-            lruSliceCaches_.emplace_back(new ILruCache<Key, Value>(sliceSize));
-        }
+                                 : std::thread::hardware_concurrency()),
+          weighted_(false),
+          lruSliceCaches_(sliceNum_, sliceCapacity(capacity_), defaultTtl) {}
+
+    // 按字节预算限制容量，每个分片得到总预算的 1/sliceNum
+    IHashLruCaches(
+        size_t maxWeight, int sliceNum,
+        typename ILruCache<Key, Value>::Weigher weigher,
+        std::chrono::milliseconds defaultTtl = std::chrono::milliseconds(0))
+        : capacity_(maxWeight),
+          sliceNum_(sliceNum > 0 ? sliceNum
+                                 : std::thread::hardware_concurrency()),
+          weighted_(true),
+          lruSliceCaches_(sliceNum_, sliceCapacity(capacity_), weigher,
+                          defaultTtl) {}
+
+    void put(Key key, Value value) { insertOrAssign(key, std::move(value)); }
+
+    bool get(Key key, Value& value) { return tryGet(key, value); }
+
+    // 开启热点键复制（IHotKeyReplicas.h）：对读取采样，把占总读取比例不低于
+    // minShare 的键（至多 maxKeys 个）复制到按线程分条的副本，读取热点键时
+    // 不再争抢其所在分片的锁。副本中的条目在分片淘汰、删除、替换该结点或
+    // 到期后立即失效；被采样的读取仍然访问分片，热点键在分片中保持最近访问。
+    // 须在并发访问开始前调用；lookup、getOrLoad 和 multiGet 不经过副本
+    void enableHotKeyReplication(size_t maxKeys = kHotKeyMaxKeys,
+                                 double minShare = kHotKeyMinShare) {
+        hotKeys_ = std::make_unique<HotKeyReplicas<
+            Key, Value, typename ILruCache<Key, Value>::Handle>>(
+            sliceNum_, maxKeys, minShare);
     }
 
-    void put(Key key, Value value) {
+    // 当前被复制的热点键，未开启复制时为空
+    std::vector<Key> hotKeys() {
+        return hotKeys_ ? hotKeys_->keys() : std::vector<Key>();
+    }
+
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
         // 获取 key 的 hash 值，并计算出对应的分片索引
-        size_t sliceIndex = Hash(key) % sliceNum_;
-        lruSliceCaches_[sliceIndex]->put(key, value);
+        uint64_t hash = mixedHash(key);
+        lruSliceCaches_[shardOf(hash, sliceNum_)].insertOrAssign(
+            key, std::forward<V>(value));
+        invalidateHotKey(key, hash);
+    }
+
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value,
+                        std::chrono::milliseconds ttl) {
+        uint64_t hash = mixedHash(key);
+        lruSliceCaches_[shardOf(hash, sliceNum_)].insertOrAssign(
+            key, std::forward<V>(value), ttl);
+        invalidateHotKey(key, hash);
     }
 
-    bool get(Key key, Value& value) {
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        uint64_t hash = mixedHash(key);
+        bool inserted = lruSliceCaches_[shardOf(hash, sliceNum_)].emplace(
+            key, std::forward<Args>(args)...);
+        if (inserted) {
+            // 副本中可能还留着该键被淘汰之前的结点
+            invalidateHotKey(key, hash);
+        }
+        return inserted;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
         // 获取 key 的 hash 值，并计算出对应的分片索引
-        size_t sliceIndex = Hash(key) % sliceNum_;
-        return lruSliceCaches_[sliceIndex]->get(key, value);
+        uint64_t hash = mixedHash(key);
+        size_t sliceIndex = shardOf(hash, sliceNum_);
+        if (hotKeys_) {
+            // 先采样再读副本，已被复制的热点键仍然计入统计，不会被降级；
+            // 被采样的读取直接读分片，更新热点键在分片中的访问顺序
+            bool refresh = false;
+            if (hotKeys_->sample(key, hash, sliceIndex, refresh)) {
+                if (refresh) {
+                    refreshHotKeys();
+                }
+            } else if (hotKeys_->tryGet(key, hash, value)) {
+                return true;
+            }
+        }
+        return lruSliceCaches_[sliceIndex].tryGet(key, value);
     }
 
     Value get(Key key) {
@@ -270,17 +774,194 @@ class IHashLruCaches {
         return value;
     }
 
+    template <typename K>
+    typename ILruCache<Key, Value>::Handle lookup(const K& key) {
+        size_t sliceIndex = sliceOf(key);
+        return lruSliceCaches_[sliceIndex].lookup(key);
+    }
+
+    // 由 key 所在分片合并并发加载，不同分片的加载互不阻塞
+    template <typename Loader>
+    Value getOrLoad(const Key& key, Loader&& loader) {
+        uint64_t hash = mixedHash(key);
+        bool loaded = false;
+        Value value = lruSliceCaches_[shardOf(hash, sliceNum_)].getOrLoad(
+            key, std::forward<Loader>(loader), loaded);
+        if (loaded) {
+            // 本次调用加载的值写入了分片
+            invalidateHotKey(key, hash);
+        }
+        return value;
+    }
+
+    // 批量读取：先计算全部键的哈希并按分片分组，每个分片只加锁一次。
+    // 命中的 keys[i] 写入 values[i] 并把 found[i] 置为 true，返回命中数；
+    // values 和 found 的长度不小于 keys
+    size_t multiGet(std::span<const Key> keys, std::span<Value> values,
+                    std::span<bool> found) {
+        ShardBatch batch;
+        groupByShard(keys, sliceNum_, batch);
+        size_t hits = 0;
+        for (int i = 0; i < sliceNum_; i++) {
+            std::span<const uint32_t> indices = batch.shard(i);
+            if (!indices.empty()) {
+                hits += lruSliceCaches_[i].tryGetBatch(keys, batch.hashes,
+                                                       indices, values, found);
+            }
+        }
+        return hits;
+    }
+
+    // 批量写入：keys[i] 对应 values[i]，按分片分组后每个分片只加锁一次
+    void multiPut(std::span<const Key> keys, std::span<const Value> values) {
+        ShardBatch batch;
+        groupByShard(keys, sliceNum_, batch);
+        for (int i = 0; i < sliceNum_; i++) {
+            std::span<const uint32_t> indices = batch.shard(i);
+            if (!indices.empty()) {
+                lruSliceCaches_[i].insertOrAssignBatch(keys, batch.hashes,
+                                                       indices, values);
+            }
+        }
+        if (hotKeys_) {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                invalidateHotKey(keys[i], mixHash(batch.hashes[i]));
+            }
+        }
+    }
+
+    // 删除指定元素，同时移除热点键副本中的该键
+    template <typename K>
+    void remove(const K& key) {
+        uint64_t hash = mixedHash(key);
+        lruSliceCaches_[shardOf(hash, sliceNum_)].remove(key);
+        invalidateHotKey(key, hash);
+    }
+
+    // 回收所有分片中已到期的条目
+    size_t purgeExpired() {
+        size_t expired = 0;
+        for (auto& slice : lruSliceCaches_) {
+            expired += slice.purgeExpired();
+        }
+        return expired;
+    }
+
+    // 在线调整总容量，按与构造时相同的规则重新分配各分片的容量；
+    // 各分片依次加锁调整，缩容时超额条目由各分片分批淘汰
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(resizeMutex_);
+        capacity_ = capacity;
+        size_t sliceSize = sliceCapacity(capacity_);
+        for (auto& slice : lruSliceCaches_) {
+            slice.setCapacity(sliceSize);
+        }
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(resizeMutex_);
+        return capacity_;
+    }
+
+    // 汇总所有分片的统计
+    CacheStats stats() {
+        CacheStats result;
+        for (auto& slice : lruSliceCaches_) {
+            result += slice.stats();
+        }
+        if (hotKeys_) {
+            result += hotKeys_->stats();  // 由副本直接命中的读取
+        }
+        return result;
+    }
+
+    void resetStats() {
+        for (auto& slice : lruSliceCaches_) {
+            slice.resetStats();
+        }
+        if (hotKeys_) {
+            hotKeys_->resetStats();
+        }
+    }
+
+    // 各分片的延迟快照，可用于定位热点分片上的锁排队
+    std::vector<CacheLatencySnapshot> shardLatencies() const {
+        std::vector<CacheLatencySnapshot> result;
+        for (const auto& slice : lruSliceCaches_) {
+            result.push_back(slice.latency());
+        }
+        return result;
+    }
+
+    // 合并所有分片的延迟快照
+    CacheLatencySnapshot latency() const {
+        CacheLatencySnapshot result;
+        for (const auto& slice : lruSliceCaches_) {
+            result += slice.latency();
+        }
+        return result;
+    }
+
+    void resetLatency() {
+        for (auto& slice : lruSliceCaches_) {
+            slice.resetLatency();
+        }
+    }
+
    private:
     // 将 key 值转换为对应的哈希值
-    size_t Hash(Key key) {
-        std::hash<Key> hashFunc;
+    template <typename K>
+    size_t Hash(const K& key) {
+        CacheHash<Key> hashFunc;
         return hashFunc(key);
     }
 
+    // 混淆后的哈希，用于分片选择和热点键副本
+    template <typename K>
+    uint64_t mixedHash(const K& key) {
+        return mixHash(Hash(key));
+    }
+
+    // 混淆 key 的哈希后取高位选择分片（见 shardOf）：std::hash 对整数是
+    // 恒等映射，直接取模会让连续或等步长的键落在相邻或同一个分片
+    template <typename K>
+    size_t sliceOf(const K& key) {
+        return shardOf(mixedHash(key), sliceNum_);
+    }
+
+    // 写入或删除分片中的键之后使热点键副本失效
+    template <typename K>
+    void invalidateHotKey(const K& key, uint64_t hash) {
+        if (hotKeys_) {
+            hotKeys_->invalidate(key, hash);
+        }
+    }
+
+    // 重新选出热点键，从所在分片取得句柄发布到副本，不计入分片的统计
+    void refreshHotKeys() {
+        hotKeys_->refresh(
+            [this](const Key& key, uint64_t hash, uint64_t& expireAt) {
+                return lruSliceCaches_[shardOf(hash, sliceNum_)].pin(key,
+                                                                     expireAt);
+            });
+    }
+
+    // 按条目数时向上取整；按字节预算时向下取整，各分片之和不超过总预算
+    size_t sliceCapacity(size_t capacity) const {
+        if (weighted_) {
+            return capacity / sliceNum_;
+        }
+        return std::ceil(capacity / static_cast<double>(sliceNum_));
+    }
+
    private:
-    size_t capacity_;  // 总容量
+    size_t capacity_;  // 总容量（条目数或字节数）
     int sliceNum_;     // 切片数量
-    std::vector<std::unique_ptr<ILruCache<Key, Value>>>
-        lruSliceCaches_;  // 切片 LRU 缓存
+    bool weighted_;    // 是否按字节预算
+    std::mutex resizeMutex_;  // 串行化 setCapacity
+    ShardArray<ILruCache<Key, Value>> lruSliceCaches_;  // 切片 LRU 缓存
+    std::unique_ptr<
+        HotKeyReplicas<Key, Value, typename ILruCache<Key, Value>::Handle>>
+        hotKeys_;  // 热点键副本，未开启复制时为空
 };
 }  // namespace IncreCache
\ No newline at end of file
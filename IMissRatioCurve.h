@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "IHashMix.h"
+
+namespace IncreCache {
+// 按访问时间戳排序的 treap，用于统计某个时间戳之后有多少个不同的键被访问过
+// 结点存放在数组中，下标 0 作为空结点
+class AccessTimeTree {
+   public:
+    AccessTimeTree() : root_(0) { nodes_.push_back(TreapNode{}); }
+
+    // 时间戳严格大于 time 的结点数
+    uint64_t countAfter(uint64_t time) const {
+        uint64_t count = 0;
+        uint32_t cur = root_;
+        while (cur) {
+            const TreapNode& node = nodes_[cur];
+            if (node.time > time) {
+                count += nodes_[node.right].size + 1;
+                cur = node.left;
+            } else {
+                cur = node.right;
+            }
+        }
+        return count;
+    }
+
+    // 插入新的时间戳，要求大于树中所有时间戳
+    void pushBack(uint64_t time) {
+        uint32_t index = acquireNode();
+        TreapNode& node = nodes_[index];
+        node.time = time;
+        node.priority = static_cast<uint32_t>(mixHash(time) >> 32);
+        node.left = node.right = 0;
+        node.size = 1;
+        root_ = merge(root_, index);
+    }
+
+    // 删除一个已存在的时间戳
+    void erase(uint64_t time) { root_ = eraseFrom(root_, time); }
+
+    uint64_t size() const { return nodes_[root_].size; }
+
+   private:
+    struct TreapNode {
+        uint64_t time = 0;
+        uint32_t priority = 0;
+        uint32_t left = 0;
+        uint32_t right = 0;
+        uint32_t size = 0;
+    };
+
+    void update(uint32_t index) {
+        TreapNode& node = nodes_[index];
+        node.size = nodes_[node.left].size + nodes_[node.right].size + 1;
+    }
+
+    // 合并两棵树，a 中的时间戳都小于 b
+    uint32_t merge(uint32_t a, uint32_t b) {
+        if (!a || !b) {
+            return a ? a : b;
+        }
+        if (nodes_[a].priority > nodes_[b].priority) {
+            uint32_t right = merge(nodes_[a].right, b);
+            nodes_[a].right = right;
+            update(a);
+            return a;
+        }
+        uint32_t left = merge(a, nodes_[b].left);
+        nodes_[b].left = left;
+        update(b);
+        return b;
+    }
+
+    uint32_t eraseFrom(uint32_t index, uint64_t time) {
+        if (!index) {
+            return 0;
+        }
+        TreapNode& node = nodes_[index];
+        if (node.time == time) {
+            uint32_t merged = merge(node.left, node.right);
+            freeNodes_.push_back(index);
+            return merged;
+        }
+        if (time < node.time) {
+            node.left = eraseFrom(node.left, time);
+        } else {
+            node.right = eraseFrom(node.right, time);
+        }
+        update(index);
+        return index;
+    }
+
+    uint32_t acquireNode() {
+        if (!freeNodes_.empty()) {
+            uint32_t index = freeNodes_.back();
+            freeNodes_.pop_back();
+            return index;
+        }
+        nodes_.push_back(TreapNode{});
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+   private:
+    uint32_t root_;
+    std::vector<TreapNode> nodes_;
+    std::vector<uint32_t> freeNodes_;
+};
+
+// LRU 缺失率曲线（MRC）：一次扫描得到所有缓存容量下的 LRU 缺失率
+//
+// 每次访问的栈距离（Mattson）等于该键上次访问之后被访问过的不同键数量，
+// 栈距离小于容量 C 的访问在容量为 C 的 LRU 中命中。
+// 支持 SHARDS 空间采样：只跟踪 hash(key) mod P < T 的键，采样率 R = T / P，
+// 采样键上测得的栈距离按 1/R 放大。
+//   固定采样率：maxSamples 为 0，内存随不同键数量按 R 线性增长
+//   固定容量：  maxSamples > 0，跟踪的键超过上限时不断降低 T，内存有界
+// 计算曲线时使用 SHARDS_adj 修正：把期望采样数与实际采样数之差计入最小距离
+class MissRatioCurve {
+   public:
+    // samplingRate：初始采样率，1 表示不采样
+    // bucketWidth：直方图每格覆盖的缓存容量，容量很大时可以调大以节省内存
+    explicit MissRatioCurve(double samplingRate = 1.0, size_t maxSamples = 0,
+                            size_t bucketWidth = 1)
+        : threshold_(static_cast<uint64_t>(
+              std::clamp(samplingRate, 0.0, 1.0) * kModulus)),
+          maxSamples_(maxSamples),
+          bucketWidth_(std::max<size_t>(bucketWidth, 1)),
+          references_(0),
+          clock_(0),
+          coldMisses_(0) {
+        threshold_ = std::max<uint64_t>(threshold_, 1);
+    }
+
+    // 记录一次访问
+    template <typename Key>
+    void access(const Key& key) {
+        accessHash(mixHash(std::hash<Key>()(key)));
+    }
+
+    // 记录一次访问，hash 需已经充分混淆
+    void accessHash(uint64_t hash) {
+        ++references_;
+        uint64_t sample = hash & (kModulus - 1);
+        if (sample >= threshold_) {
+            return;
+        }
+        uint64_t now = ++clock_;
+        auto it = lastAccess_.find(hash);
+        if (it == lastAccess_.end()) {
+            // 第一次访问，任何容量下都不命中
+            coldMisses_ += 1;
+            tree_.pushBack(now);
+            lastAccess_.emplace(hash, now);
+            if (maxSamples_ > 0) {
+                samples_.emplace(sample, hash);
+                while (lastAccess_.size() > maxSamples_) {
+                    lowerThreshold();
+                }
+            }
+            return;
+        }
+        uint64_t distance = tree_.countAfter(it->second);
+        tree_.erase(it->second);
+        tree_.pushBack(now);
+        it->second = now;
+        size_t bucket = static_cast<size_t>(
+            distance / samplingRate() / static_cast<double>(bucketWidth_));
+        if (bucket >= histogram_.size()) {
+            histogram_.resize(bucket + 1, 0.0);
+        }
+        histogram_[bucket] += 1;
+    }
+
+    // 容量为 cacheSize 的 LRU 的缺失率
+    double missRatio(size_t cacheSize) const {
+        return curve(std::vector<size_t>{cacheSize}).front();
+    }
+
+    // 按给定容量（升序）批量计算缺失率，只遍历一次直方图
+    std::vector<double> curve(const std::vector<size_t>& cacheSizes) const {
+        double total = coldMisses_;
+        for (double count : histogram_) {
+            total += count;
+        }
+        // SHARDS_adj：期望采样数与实际采样数的差归入距离最小的一格
+        double adjustment =
+            static_cast<double>(references_) * samplingRate() - total;
+        total += adjustment;
+
+        std::vector<double> ratios;
+        ratios.reserve(cacheSizes.size());
+        double hits = 0;
+        size_t bucket = 0;
+        for (size_t cacheSize : cacheSizes) {
+            // 第 b 格的距离都小于 (b + 1) * bucketWidth
+            size_t bucketEnd = cacheSize / bucketWidth_;
+            for (; bucket < bucketEnd && bucket < histogram_.size(); ++bucket) {
+                hits += histogram_[bucket] + (bucket == 0 ? adjustment : 0);
+            }
+            double ratio = total > 0 ? 1.0 - hits / total : 0.0;
+            ratios.push_back(std::clamp(ratio, 0.0, 1.0));
+        }
+        return ratios;
+    }
+
+    // 当前采样率
+    double samplingRate() const {
+        return static_cast<double>(threshold_) / kModulus;
+    }
+
+    uint64_t references() const { return references_; }
+
+    // 正在跟踪的不同键数量
+    size_t trackedKeys() const { return lastAccess_.size(); }
+
+   private:
+    static constexpr uint64_t kModulus = 1ULL << 24;  // 采样哈希空间 P
+
+    // 固定容量模式：淘汰采样值最大的键并把阈值 T 降到该值，
+    // 直方图按新旧采样率之比缩放，与以新采样率从头采样的期望一致
+    void lowerThreshold() {
+        double oldRate = samplingRate();
+        uint64_t newThreshold = samples_.top().first;
+        while (!samples_.empty() && samples_.top().first >= newThreshold) {
+            uint64_t hash = samples_.top().second;
+            samples_.pop();
+            auto it = lastAccess_.find(hash);
+            tree_.erase(it->second);
+            lastAccess_.erase(it);
+        }
+        threshold_ = std::max<uint64_t>(newThreshold, 1);
+        double scale = samplingRate() / oldRate;
+        for (double& count : histogram_) {
+            count *= scale;
+        }
+        coldMisses_ *= scale;
+    }
+
+   private:
+    uint64_t threshold_;   // 采样阈值 T
+    size_t maxSamples_;    // 固定容量模式下跟踪的键数上限，0 表示固定采样率
+    size_t bucketWidth_;   // 直方图每格的宽度
+    uint64_t references_;  // 访问总数（含未采样的访问）
+    uint64_t clock_;       // 采样访问的逻辑时间
+    double coldMisses_;    // 首次访问次数
+
+    AccessTimeTree tree_;                             // 各键最近一次访问时间
+    std::unordered_map<uint64_t, uint64_t> lastAccess_;  // 键哈希 -> 访问时间
+    std::vector<double> histogram_;  // 放大后的栈距离直方图
+    // 固定容量模式下按采样值排序的已跟踪键，堆顶为下一个被淘汰的键
+    std::priority_queue<std::pair<uint64_t, uint64_t>> samples_;
+};
+}  // namespace IncreCache
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace IncreCache {
+// 分段数组：第一段按构造时的大小一次分配，扩容时在末尾追加新段，
+// 追加的段依次为 G、2G、4G ...（G 为不小于第一段大小的 2 的幂）。
+// 扩容不移动也不复制已有元素，下标和引用始终有效；
+// 下标落在第一段时只比直接下标多一次比较，之后的段用一次位运算定位
+template <typename T>
+class SegmentedArray {
+   public:
+    explicit SegmentedArray(size_t size)
+        : base_(std::make_unique<T[]>(size)),
+          baseSize_(size),
+          size_(size),
+          growShift_(std::countr_zero(
+              std::bit_ceil(std::max<size_t>(size, 1)))) {}
+
+    T& operator[](size_t index) { return *at(index); }
+
+    const T& operator[](size_t index) const { return *at(index); }
+
+    // 已分配的元素数量
+    size_t size() const { return size_; }
+
+    // 追加新段直到至少容纳 size 个元素，新元素值初始化
+    void grow(size_t size) {
+        while (size_ < size) {
+            size_t segmentSize = size_t(1) << (growShift_ + segments_.size());
+            segments_.push_back(std::make_unique<T[]>(segmentSize));
+            size_ += segmentSize;
+        }
+    }
+
+   private:
+    // 第 k 个追加段覆盖偏移 [G * (2^k - 1), G * (2^(k+1) - 1))
+    T* at(size_t index) const {
+        if (index < baseSize_) {
+            return &base_[index];
+        }
+        size_t offset = index - baseSize_;
+        size_t segment = std::bit_width((offset >> growShift_) + 1) - 1;
+        return &segments_[segment]
+                         [offset - (((size_t(1) << segment) - 1) << growShift_)];
+    }
+
+   private:
+    std::unique_ptr<T[]> base_;                   // 第一段
+    size_t baseSize_;                             // 第一段的元素数量
+    size_t size_;                                 // 所有段的元素数量之和
+    size_t growShift_;                            // log2(G)
+    std::vector<std::unique_ptr<T[]>> segments_;  // 追加的段
+};
+}  // namespace IncreCache
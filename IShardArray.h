@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace IncreCache {
+// 隔离写竞争所用的缓存行大小。x86 的相邻行预取器按 128 字节成对加载缓存行，
+// 只按 64 字节隔开时相邻的两行仍会互相干扰
+constexpr size_t kCacheLineSize = 128;
+
+// 分片数组：所有分片在一块按缓存行对齐的连续内存中就地构造，
+// 每个分片占用的空间补齐到缓存行的整数倍，相邻分片不会共享缓存行，
+// 也不会与分配器放在旁边的其他对象共享缓存行。
+// 分片数在构造时确定，之后不再变化，分片的地址始终不变
+template <typename T>
+class ShardArray {
+   public:
+    // 构造 count 个分片，每个分片都以 args 构造
+    template <typename... Args>
+    explicit ShardArray(size_t count, const Args&... args)
+        : data_(static_cast<unsigned char*>(::operator new(
+              count * kStride, std::align_val_t(kAlignment)))),
+          count_(0) {
+        try {
+            for (; count_ < count; ++count_) {
+                new (data_ + count_ * kStride) T(args...);
+            }
+        } catch (...) {
+            destroy();
+            throw;
+        }
+    }
+
+    ShardArray(const ShardArray&) = delete;
+    ShardArray& operator=(const ShardArray&) = delete;
+
+    ~ShardArray() { destroy(); }
+
+    size_t size() const { return count_; }
+
+    T& operator[](size_t index) { return *at(index); }
+
+    const T& operator[](size_t index) const { return *at(index); }
+
+    // 依次访问各分片，供范围 for 使用
+    template <typename Shard>
+    class Iterator {
+       public:
+        Iterator(const ShardArray* array, size_t index)
+            : array_(array), index_(index) {}
+
+        Shard& operator*() const { return *array_->at(index_); }
+
+        Iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return index_ != other.index_;
+        }
+
+       private:
+        const ShardArray* array_;
+        size_t index_;
+    };
+
+    Iterator<T> begin() { return Iterator<T>(this, 0); }
+
+    Iterator<T> end() { return Iterator<T>(this, count_); }
+
+    Iterator<const T> begin() const { return Iterator<const T>(this, 0); }
+
+    Iterator<const T> end() const { return Iterator<const T>(this, count_); }
+
+   private:
+    static constexpr size_t kAlignment =
+        alignof(T) > kCacheLineSize ? alignof(T) : kCacheLineSize;
+    // 相邻分片的间距：sizeof(T) 向上补齐到对齐单位的整数倍
+    static constexpr size_t kStride =
+        (sizeof(T) + kAlignment - 1) / kAlignment * kAlignment;
+
+    T* at(size_t index) const {
+        return std::launder(reinterpret_cast<T*>(data_ + index * kStride));
+    }
+
+    void destroy() {
+        while (count_ > 0) {
+            at(--count_)->~T();
+        }
+        ::operator delete(data_, std::align_val_t(kAlignment));
+    }
+
+   private:
+    unsigned char* data_;  // 按 kAlignment 对齐的连续内存
+    size_t count_;         // 已构造的分片数量
+};
+}  // namespace IncreCache
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <exception>
+#include <future>
+#include <mutex>
+#include <utility>
+
+#include "ICacheKey.h"
+
+namespace IncreCache {
+// 合并同一个键上的并发加载：第一个调用方（领头者）执行 loader，
+// 在它完成之前到达的调用方不再执行 loader，而是等待同一个结果。
+// loader 抛出的异常原样传给领头者和所有等待者，加载失败的结果不会保留，
+// 之后的调用会重新加载
+template <typename Key, typename Value>
+class SingleFlight {
+   public:
+    template <typename Loader>
+    Value run(const Key& key, Loader&& loader) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it != calls_.end()) {
+            // 已有加载在进行，释放锁后等待其结果
+            std::shared_future<Value> result = it->second;
+            lock.unlock();
+            return result.get();
+        }
+        std::promise<Value> promise;
+        calls_.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        try {
+            Value value = loader();
+            promise.set_value(value);
+            finish(key);
+            return value;
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            finish(key);
+            throw;
+        }
+    }
+
+    // 当前正在进行的加载数量
+    size_t inFlight() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.size();
+    }
+
+   private:
+    void finish(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.erase(key);
+    }
+
+   private:
+    std::mutex mutex_;
+    IndexMap<Key, std::shared_future<Value>> calls_;  // 键 -> 进行中的加载
+};
+}  // namespace IncreCache
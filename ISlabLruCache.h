@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ICacheKey.h"
+#include "ICachePolicy.h"
+#include "ICacheStats.h"
+#include "ISegmentedArray.h"
+
+namespace IncreCache {
+template <typename Key, typename Value>
+class ISlabLruCache;
+
+template <typename Key, typename Value>
+class SlabLruNode {
+   private:
+    Key key_;
+    Value value_;
+    uint32_t prev_;      // 链表前驱下标
+    uint32_t next_;      // 链表后继下标（空闲时作为空闲链表的指针）
+    uint32_t hashNext_;  // 同一哈希桶内下一个结点的下标
+
+   public:
+    SlabLruNode() : key_(), value_(), prev_(0), next_(0), hashNext_(0) {}
+
+    Key getKey() const { return key_; }
+
+    Value getValue() const { return value_; }
+
+    friend class ISlabLruCache<Key, Value>;
+};
+
+// LRU 优化，结点存放在按容量预分配的 slab 中，通过下标互相链接
+// 稳态下 get/put 不产生堆分配，也没有 shared_ptr 引用计数的原子操作。
+// 扩容时 slab 追加新段，已有结点不移动
+template <typename Key, typename Value>
+class ISlabLruCache
+    : public ICachePolicyAdapter<ISlabLruCache<Key, Value>, Key, Value> {
+   public:
+    using NodeType = SlabLruNode<Key, Value>;
+
+    explicit ISlabLruCache(int capacity)
+        : capacity_(clampCapacity(capacity > 0 ? capacity : 0)),
+          size_(0),
+          freeHead_(kNil),
+          slab_(capacity_ + 1) {
+        initializeSlab();
+    }
+
+    ~ISlabLruCache() override = default;
+
+    // 插入或更新，右值 value 直接移动到槽位中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return;
+        }
+        uint32_t index = findNode(key);
+        if (index != kNil) {
+            // 已存在则更新 value，并移动到最新的位置
+            slab_[index].value_ = std::forward<V>(value);
+            moveToMostRecent(index);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        addNewNode(key, std::forward<V>(value));
+        stats_.record(StatCounter::Puts);
+    }
+
+    // 键不存在时用 args 构造 value 并插入，返回是否插入；键已存在时不做任何修改
+    // 槽位中的 value 是预先构造好的，这里构造临时对象后移动赋值进去
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return false;
+        }
+        if (findNode(key) != kNil) {
+            return false;
+        }
+        addNewNode(key, Value(std::forward<Args>(args)...));
+        stats_.record(StatCounter::Puts);
+        return true;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        uint32_t index = findNode(key);
+        if (index == kNil) {
+            stats_.record(StatCounter::Misses);
+            return false;
+        }
+        moveToMostRecent(index);
+        value = slab_[index].value_;
+        stats_.record(StatCounter::Hits);
+        return true;
+    }
+
+    // 读取 value，不调整访问顺序，也不计入命中和未命中统计
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        uint32_t index = findNode(key);
+        if (index == kNil) {
+            return false;
+        }
+        value = slab_[index].value_;
+        return true;
+    }
+
+    // 删除指定元素，槽位归还到空闲链表
+    template <typename K>
+    void remove(const K& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t index = findNode(key);
+        if (index != kNil) {
+            removeNode(index);
+            unlinkFromBucket(index);
+            // 释放 value 持有的资源，key 保留到槽位复用时覆盖
+            slab_[index].value_ = Value();
+            releaseSlot(index);
+        }
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = size_;
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 在线调整容量（见 kResizeEvictionStep）。扩容时 slab 追加新段，新槽位加入
+    // 空闲链表，已有结点不移动，哈希桶随写入按需翻倍；缩容不归还 slab，
+    // 被淘汰的 value 已释放。超过 kMaxCapacity 的容量按 kMaxCapacity 处理
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity = clampCapacity(capacity);
+        size_t oldSize = slab_.size();
+        slab_.grow(capacity + 1);
+        // 追加的段可能超出 uint32_t 下标范围，超出的槽位不加入空闲链表
+        size_t last = std::min<size_t>(slab_.size() - 1, kMaxCapacity);
+        for (size_t i = last; i >= oldSize; --i) {
+            slab_[i].next_ = freeHead_;
+            freeHead_ = static_cast<uint32_t>(i);
+        }
+        capacity_ = capacity;
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+   private:
+    // 下标 0 为哨兵结点，同时作为链表和哈希链的空值
+    static constexpr uint32_t kNil = 0;
+    // 槽位下标为 uint32_t 且 0 留给哨兵，下标 UINT32_MAX 也不使用
+    static constexpr size_t kMaxCapacity = UINT32_MAX - 1;
+
+    static size_t clampCapacity(size_t capacity) {
+        return std::min(capacity, kMaxCapacity);
+    }
+
+    void initializeSlab() {
+        // 哨兵结点自成环：next_ 指向最久未访问结点，prev_ 指向最近访问结点
+        slab_[kNil].prev_ = kNil;
+        slab_[kNil].next_ = kNil;
+        // 除哨兵外的所有槽位串成空闲链表
+        for (uint32_t i = static_cast<uint32_t>(capacity_); i > 0; --i) {
+            slab_[i].next_ = freeHead_;
+            freeHead_ = i;
+        }
+        // 桶数量取不小于容量的 2 的幂，用掩码代替取模
+        size_t bucketCount = 1;
+        while (bucketCount < capacity_) {
+            bucketCount <<= 1;
+        }
+        buckets_.assign(bucketCount, kNil);
+        bucketMask_ = bucketCount - 1;
+    }
+
+    // 扩容后结点数超过桶数时桶数翻倍，按新掩码重新串起所有结点
+    void growBuckets() {
+        buckets_.assign(buckets_.size() * 2, kNil);
+        bucketMask_ = buckets_.size() - 1;
+        for (uint32_t index = slab_[kNil].next_; index != kNil;
+             index = slab_[index].next_) {
+            size_t bucket = bucketOf(slab_[index].key_);
+            slab_[index].hashNext_ = buckets_[bucket];
+            buckets_[bucket] = index;
+        }
+    }
+
+    // 缩容后淘汰至多 kResizeEvictionStep 个超额条目
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep && size_ > capacity_; ++n) {
+            evictLeastRecent();
+        }
+    }
+
+    template <typename K>
+    size_t bucketOf(const K& key) const {
+        return CacheHash<Key>()(key) & bucketMask_;
+    }
+
+    template <typename K>
+    uint32_t findNode(const K& key) const {
+        uint32_t index = buckets_[bucketOf(key)];
+        while (index != kNil && !(slab_[index].key_ == key)) {
+            index = slab_[index].hashNext_;
+        }
+        return index;
+    }
+
+    template <typename V>
+    void addNewNode(const Key& key, V&& value) {
+        // 缩容后超额条目尚未淘汰完时，淘汰一个再插入，不增加超额部分
+        if (size_ >= capacity_) {
+            evictLeastRecent();
+        } else if (size_ >= buckets_.size()) {
+            growBuckets();
+        }
+        uint32_t index = acquireSlot();
+        NodeType& node = slab_[index];
+        // 复用槽位中已有的对象，赋值而非重新构造
+        node.key_ = key;
+        node.value_ = std::forward<V>(value);
+        size_t bucket = bucketOf(key);
+        node.hashNext_ = buckets_[bucket];
+        buckets_[bucket] = index;
+        insertNode(index);
+        ++size_;
+    }
+
+    // 将该结点移动到最新的位置
+    void moveToMostRecent(uint32_t index) {
+        removeNode(index);
+        insertNode(index);
+    }
+
+    void removeNode(uint32_t index) {
+        NodeType& node = slab_[index];
+        slab_[node.prev_].next_ = node.next_;
+        slab_[node.next_].prev_ = node.prev_;
+    }
+
+    // 从尾部（最近访问端）插入结点
+    void insertNode(uint32_t index) {
+        NodeType& node = slab_[index];
+        node.prev_ = slab_[kNil].prev_;
+        node.next_ = kNil;
+        slab_[node.prev_].next_ = index;
+        slab_[kNil].prev_ = index;
+    }
+
+    void unlinkFromBucket(uint32_t index) {
+        uint32_t* link = &buckets_[bucketOf(slab_[index].key_)];
+        while (*link != index) {
+            link = &slab_[*link].hashNext_;
+        }
+        *link = slab_[index].hashNext_;
+        slab_[index].hashNext_ = kNil;
+    }
+
+    // 驱逐最近最少访问
+    void evictLeastRecent() {
+        uint32_t leastRecent = slab_[kNil].next_;
+        if (leastRecent == kNil) {
+            return;
+        }
+        removeNode(leastRecent);
+        unlinkFromBucket(leastRecent);
+        // 与 remove 一致，立即释放被淘汰 value 持有的资源
+        slab_[leastRecent].value_ = Value();
+        releaseSlot(leastRecent);
+        stats_.record(StatCounter::Evictions);
+    }
+
+    uint32_t acquireSlot() {
+        uint32_t index = freeHead_;
+        freeHead_ = slab_[index].next_;
+        return index;
+    }
+
+    void releaseSlot(uint32_t index) {
+        slab_[index].next_ = freeHead_;
+        freeHead_ = index;
+        --size_;
+    }
+
+   private:
+    size_t capacity_;                // 缓存容量
+    size_t size_;                    // 当前结点数量
+    uint32_t freeHead_;              // 空闲槽位链表头
+    size_t bucketMask_;              // 桶下标掩码
+    SegmentedArray<NodeType> slab_;  // 结点存储，下标 0 为哨兵
+    std::vector<uint32_t> buckets_;  // 哈希桶，存放链头结点下标
+    std::mutex mutex_;
+    StatsRecorder stats_;            // 命中、淘汰等统计计数
+};
+}  // namespace IncreCache
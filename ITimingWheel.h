@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace IncreCache {
+// 单调时钟的当前时间（毫秒），作为过期时刻的时间基准
+inline uint64_t steadyNowMillis() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+// 嵌入在缓存结点中的定时器链接，由时间轮串成双向循环链表
+template <typename Owner>
+struct TimerLink {
+    TimerLink* prev = nullptr;
+    TimerLink* next = nullptr;
+    Owner* owner = nullptr;  // 所在结点，时间轮的哨兵为空
+    uint64_t expireAt = 0;   // 过期时刻（毫秒），0 表示不过期
+
+    bool scheduled() const { return prev != nullptr; }
+};
+
+// 分层时间轮：共 kLevels 层，每层 kSlots 个槽，第 i 层每个槽跨 64^i 毫秒，
+// 各层覆盖 64 毫秒、4 秒、4 分钟、4.6 小时和 12 天，更远的过期时刻放在最高层。
+// 登记和取消都是 O(1) 的链表操作；推进时只处理时间走过的槽，
+// 到期的结点交给回调，未到期的结点（高层槽里的）重新登记到更低层，
+// 每个结点最多被重新登记 kLevels 次，不需要扫描全部条目
+template <typename Owner>
+class TimingWheel {
+   public:
+    using Link = TimerLink<Owner>;
+
+    TimingWheel() : currentTick_(steadyNowMillis()), size_(0) {
+        for (auto& level : wheel_) {
+            for (Link& sentinel : level) {
+                sentinel.prev = &sentinel;
+                sentinel.next = &sentinel;
+            }
+        }
+    }
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    // 登记（或改期）一个定时器，expireAt 为绝对时刻（毫秒）
+    void schedule(Link* link, uint64_t expireAt) {
+        if (link->scheduled()) {
+            unlink(link);
+        } else {
+            ++size_;
+        }
+        link->expireAt = expireAt;
+        append(bucketOf(expireAt), link);
+    }
+
+    // 取消定时器，未登记时什么也不做
+    void cancel(Link* link) {
+        if (link->scheduled()) {
+            unlink(link);
+            link->expireAt = 0;
+            --size_;
+        }
+    }
+
+    // 把时间推进到 now，对每个到期结点调用 onExpire(Owner*)，返回到期数量。
+    // 回调时结点已经从时间轮摘下，可以直接释放
+    template <typename OnExpire>
+    size_t advance(uint64_t now, OnExpire&& onExpire) {
+        if (now <= currentTick_) {
+            return 0;
+        }
+        uint64_t previous = currentTick_;
+        currentTick_ = now;
+        size_t expired = 0;
+        for (int level = 0; level < kLevels; ++level) {
+            uint64_t previousTicks = previous >> shiftOf(level);
+            uint64_t currentTicks = now >> shiftOf(level);
+            if (currentTicks <= previousTicks) {
+                break;
+            }
+            expired += expireLevel(level, previousTicks, currentTicks, now,
+                                   onExpire);
+        }
+        return expired;
+    }
+
+   private:
+    static constexpr int kLevels = 5;
+    static constexpr int kSlotBits = 6;
+    static constexpr uint64_t kSlots = 1ULL << kSlotBits;
+
+    static int shiftOf(int level) { return level * kSlotBits; }
+
+    // 按距当前时刻的时长选择层，再按过期时刻在该层的刻度选择槽；
+    // 已经过期的时刻放进下一毫秒的槽，下一次推进时立即处理
+    Link* bucketOf(uint64_t expireAt) {
+        uint64_t time = std::max(expireAt, currentTick_ + 1);
+        uint64_t duration = time - currentTick_;
+        for (int level = 0; level < kLevels - 1; ++level) {
+            if (duration < (1ULL << shiftOf(level + 1))) {
+                return &wheel_[level][(time >> shiftOf(level)) & (kSlots - 1)];
+            }
+        }
+        int top = kLevels - 1;
+        return &wheel_[top][(time >> shiftOf(top)) & (kSlots - 1)];
+    }
+
+    // 处理第 level 层从 previousTicks 到 currentTicks 的槽，
+    // 包含上次推进停留的槽，那之后登记进来的结点也要检查
+    template <typename OnExpire>
+    size_t expireLevel(int level, uint64_t previousTicks,
+                       uint64_t currentTicks, uint64_t now,
+                       OnExpire& onExpire) {
+        uint64_t delta = currentTicks - previousTicks;
+        uint64_t count = delta >= kSlots ? kSlots : delta + 1;
+        size_t expired = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            Link& sentinel = wheel_[level][(previousTicks + i) & (kSlots - 1)];
+            if (sentinel.next == &sentinel) {
+                continue;
+            }
+            // 先把整条链表摘下，重新登记的结点可能落回同一个槽
+            Link* link = sentinel.next;
+            sentinel.prev->next = nullptr;
+            sentinel.prev = &sentinel;
+            sentinel.next = &sentinel;
+            while (link != nullptr) {
+                Link* next = link->next;
+                link->prev = nullptr;
+                link->next = nullptr;
+                if (link->expireAt <= now) {
+                    link->expireAt = 0;
+                    --size_;
+                    ++expired;
+                    onExpire(link->owner);
+                } else {
+                    append(bucketOf(link->expireAt), link);
+                }
+                link = next;
+            }
+        }
+        return expired;
+    }
+
+    static void append(Link* sentinel, Link* link) {
+        link->prev = sentinel->prev;
+        link->next = sentinel;
+        sentinel->prev->next = link;
+        sentinel->prev = link;
+    }
+
+    static void unlink(Link* link) {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+        link->prev = nullptr;
+        link->next = nullptr;
+    }
+
+   private:
+    Link wheel_[kLevels][kSlots];  // 各层各槽的哨兵
+    uint64_t currentTick_;         // 上次推进到的时刻（毫秒）
+    size_t size_;                  // 已登记的定时器数量
+};
+}  // namespace IncreCache
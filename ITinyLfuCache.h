@@ -0,0 +1,266 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "ICacheKey.h"
+#include "ICachePolicy.h"
+#include "ICacheStats.h"
+#include "IFrequencySketch.h"
+
+namespace IncreCache {
+// W-TinyLFU：新数据先进入小的窗口 LRU，被挤出窗口时作为候选者，
+// 与主缓存（分段 LRU）的淘汰者比较 Count-Min Sketch 估计的访问频率，
+// 频率更高者留下。每个键只占用 sketch 中的几个 4 位计数器，不保存历史值
+template <typename Key, typename Value>
+class ITinyLfuCache
+    : public ICachePolicyAdapter<ITinyLfuCache<Key, Value>, Key, Value> {
+   public:
+    // windowPercent 为窗口 LRU 占总容量的百分比
+    explicit ITinyLfuCache(int capacity, int windowPercent = 1)
+        : windowPercent_(windowPercent), sketch_(capacity > 0 ? capacity : 0) {
+        applyCapacity(capacity > 0 ? capacity : 0);
+    }
+
+    ~ITinyLfuCache() override = default;
+
+    // 插入或更新，右值 value 直接移动到条目中
+    template <typename V>
+    void insertOrAssign(const Key& key, V&& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return;
+        }
+        sketch_.increment(hashOf(key));
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            it->second->value = std::forward<V>(value);
+            onHit(it->second);
+            stats_.record(StatCounter::Updates);
+            return;
+        }
+        addNewNode(key, std::forward<V>(value));
+        stats_.record(StatCounter::Puts);
+    }
+
+    // 键不存在时用 args 构造 value 并插入，返回是否插入；
+    // 键已存在时不做任何修改（也不计入访问频率）
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        if (capacity_ == 0) {
+            return false;
+        }
+        if (nodeMap_.find(key) != nodeMap_.end()) {
+            return false;
+        }
+        sketch_.increment(hashOf(key));
+        addNewNode(key, Value(std::forward<Args>(args)...));
+        stats_.record(StatCounter::Puts);
+        return true;
+    }
+
+    template <typename K>
+    bool tryGet(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        sketch_.increment(hashOf(key));
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            stats_.record(StatCounter::Misses);
+            return false;
+        }
+        onHit(it->second);
+        value = it->second->value;
+        stats_.record(StatCounter::Hits);
+        return true;
+    }
+
+    // 读取 value，不计入频率草图和命中统计，也不调整条目所在的区段
+    template <typename K>
+    bool peek(const K& key, Value& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shrinkStep();
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) {
+            return false;
+        }
+        value = it->second->value;
+        return true;
+    }
+
+    // 统计快照
+    CacheStats stats() {
+        CacheStats result = stats_.snapshot();
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.size = nodeMap_.size();
+        return result;
+    }
+
+    void resetStats() { stats_.reset(); }
+
+    // 在线调整容量（见 kResizeEvictionStep），窗口、试用段和受保护段按构造时的
+    // 比例重新划分。扩容时 sketch 翻倍扩大，已有的频率估计保留
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sketch_.grow(capacity);
+        applyCapacity(capacity);
+        shrinkStep();
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+   private:
+    enum class Segment { Window, Probation, Protected };
+
+    struct Entry {
+        Key key;
+        Value value;
+        Segment segment;
+    };
+
+    using EntryList = std::list<Entry>;
+    using EntryIter = typename EntryList::iterator;
+
+    void applyCapacity(size_t capacity) {
+        capacity_ = capacity;
+        windowCapacity_ = capacity_ * windowPercent_ / 100;
+        if (windowCapacity_ < 1) {
+            windowCapacity_ = 1;
+        }
+        if (windowCapacity_ > capacity_) {
+            windowCapacity_ = capacity_;
+        }
+        mainCapacity_ = capacity_ - windowCapacity_;
+        // 主缓存中 80% 为受保护段，其余为试用段
+        protectedCapacity_ = mainCapacity_ * 80 / 100;
+    }
+
+    // 缩容后至多调整 kResizeEvictionStep 次：受保护段超额时降级到试用段，
+    // 总数超额时依次从试用段、受保护段、窗口中淘汰最久未访问的条目
+    void shrinkStep() {
+        for (size_t n = 0; n < kResizeEvictionStep; ++n) {
+            if (protected_.size() > protectedCapacity_) {
+                EntryIter demoted = protected_.begin();
+                demoted->segment = Segment::Probation;
+                probation_.splice(probation_.end(), protected_, demoted);
+            } else if (nodeMap_.size() > capacity_) {
+                removeEntry(shrinkVictim());
+            } else {
+                return;
+            }
+        }
+    }
+
+    // 缩容时的淘汰者：窗口超额时取窗口，否则依次取试用段、受保护段、窗口
+    EntryIter shrinkVictim() {
+        if (window_.size() <= windowCapacity_) {
+            if (!probation_.empty()) {
+                return probation_.begin();
+            }
+            if (!protected_.empty()) {
+                return protected_.begin();
+            }
+        }
+        return window_.begin();
+    }
+
+    template <typename K>
+    static size_t hashOf(const K& key) {
+        return CacheHash<Key>()(key);
+    }
+
+    EntryList& listOf(Segment segment) {
+        switch (segment) {
+            case Segment::Window:
+                return window_;
+            case Segment::Probation:
+                return probation_;
+            default:
+                return protected_;
+        }
+    }
+
+    // 命中：窗口和受保护段内移动到最近端，试用段的结点晋升到受保护段
+    void onHit(EntryIter entry) {
+        if (entry->segment != Segment::Probation) {
+            EntryList& list = listOf(entry->segment);
+            list.splice(list.end(), list, entry);
+            return;
+        }
+        entry->segment = Segment::Protected;
+        protected_.splice(protected_.end(), probation_, entry);
+        // 受保护段超出容量时，最久未访问的结点降级回试用段
+        if (protected_.size() > protectedCapacity_) {
+            EntryIter demoted = protected_.begin();
+            demoted->segment = Segment::Probation;
+            probation_.splice(probation_.end(), protected_, demoted);
+        }
+    }
+
+    template <typename V>
+    void addNewNode(const Key& key, V&& value) {
+        window_.push_back(Entry{key, std::forward<V>(value), Segment::Window});
+        nodeMap_[key] = std::prev(window_.end());
+        if (window_.size() <= windowCapacity_) {
+            return;
+        }
+        // 窗口溢出，最久未访问的结点作为候选者进入试用段
+        EntryIter candidate = window_.begin();
+        candidate->segment = Segment::Probation;
+        probation_.splice(probation_.end(), window_, candidate);
+        if (probation_.size() + protected_.size() > mainCapacity_) {
+            evictFromMain(candidate);
+        }
+    }
+
+    // 主缓存已满：候选者与试用段最久未访问的结点比较频率，淘汰较低者
+    void evictFromMain(EntryIter candidate) {
+        EntryIter victim = probation_.begin();
+        if (victim == candidate) {
+            // 试用段中只有候选者本身，从受保护段取淘汰者
+            if (protected_.empty()) {
+                removeEntry(candidate);
+                stats_.record(StatCounter::Rejections);
+                return;
+            }
+            victim = protected_.begin();
+        }
+        int candidateFreq = sketch_.frequency(hashOf(candidate->key));
+        int victimFreq = sketch_.frequency(hashOf(victim->key));
+        bool admitted = candidateFreq > victimFreq;
+        removeEntry(admitted ? victim : candidate);
+        stats_.record(admitted ? StatCounter::Admissions
+                               : StatCounter::Rejections);
+    }
+
+    void removeEntry(EntryIter entry) {
+        nodeMap_.erase(entry->key);
+        listOf(entry->segment).erase(entry);
+        stats_.record(StatCounter::Evictions);
+    }
+
+   private:
+    int windowPercent_;         // 窗口 LRU 占总容量的百分比
+    size_t capacity_;           // 缓存总容量
+    size_t windowCapacity_;     // 窗口 LRU 容量
+    size_t mainCapacity_;       // 主缓存（试用段 + 受保护段）容量
+    size_t protectedCapacity_;  // 受保护段容量
+    FrequencySketch sketch_;    // 访问频率估计器
+    std::mutex mutex_;
+    StatsRecorder stats_;       // 命中、淘汰等统计计数
+
+    EntryList window_;     // 窗口 LRU，头部为最久未访问
+    EntryList probation_;  // 试用段
+    EntryList protected_;  // 受保护段
+    IndexMap<Key, EntryIter> nodeMap_;
+};
+}  // namespace IncreCache
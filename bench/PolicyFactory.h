@@ -0,0 +1,164 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../IArcCache/IAdaptiveArcCache.h"
+#include "../IArcCache/IArcCache.h"
+#include "../IBucketLfuCache.h"
+#include "../IBufferedLruCache.h"
+#include "../ICachePolicy.h"
+#include "../IClockCache.h"
+#include "../ILfuCache.h"
+#include "../ILruCache.h"
+#include "../ISlabLruCache.h"
+#include "../ITinyLfuCache.h"
+
+// 基准测试工具共用的策略工厂：按名称创建缓存，统一通过 ICachePolicy 访问
+
+template <typename Key, typename Value>
+using PolicyPtr = std::unique_ptr<IncreCache::ICachePolicy<Key, Value>>;
+
+// 分片缓存没有继承 ICachePolicy，这里做一层转发
+template <typename Key, typename Value, typename Sharded>
+class ShardedPolicy : public IncreCache::ICachePolicy<Key, Value> {
+   public:
+    // shards 为 0 时分片数取硬件线程数
+    ShardedPolicy(size_t capacity, int shards) : cache_(capacity, shards) {}
+
+    void put(Key key, Value value) override {
+        cache_.insertOrAssign(key, std::move(value));
+    }
+
+    bool get(Key key, Value& value) override {
+        return cache_.tryGet(key, value);
+    }
+
+    Value get(Key key) override {
+        Value value{};
+        cache_.tryGet(key, value);
+        return value;
+    }
+
+    Sharded& cache() { return cache_; }
+
+   private:
+    Sharded cache_;
+};
+
+// ILruKCache 的历史记录表没有加锁，多线程测试时在外面套一把全局锁
+template <typename Key, typename Value>
+class LockedPolicy : public IncreCache::ICachePolicy<Key, Value> {
+   public:
+    explicit LockedPolicy(PolicyPtr<Key, Value> inner)
+        : inner_(std::move(inner)) {}
+
+    void put(Key key, Value value) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inner_->put(key, value);
+    }
+
+    bool get(Key key, Value& value) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inner_->get(key, value);
+    }
+
+    Value get(Key key) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inner_->get(key);
+    }
+
+   private:
+    PolicyPtr<Key, Value> inner_;
+    std::mutex mutex_;
+};
+
+// 所有可用的策略名称
+inline const std::vector<std::string>& allPolicyNames() {
+    static const std::vector<std::string> names = {
+        "lru",       "lru-k",        "hash-lru",   "lfu",
+        "hash-lfu",  "arc",          "slab-lru",   "bucket-lfu",
+        "tiny-lfu",  "buffered-lru", "clock",      "arc-adaptive",
+        "hash-lru-hot"};
+    return names;
+}
+
+// 按名称创建策略，名称未知时返回空指针；shards 为分片版本的分片数，
+// 0 表示取硬件线程数
+template <typename Key, typename Value>
+PolicyPtr<Key, Value> makePolicy(const std::string& name, size_t capacity,
+                                 int shards = 0) {
+    using namespace IncreCache;
+    int cap = static_cast<int>(capacity);
+    if (name == "lru") {
+        return std::make_unique<ILruCache<Key, Value>>(cap);
+    }
+    if (name == "lru-k") {
+        // 历史记录容量取主缓存的两倍，k = 2
+        return std::make_unique<LockedPolicy<Key, Value>>(
+            std::make_unique<ILruKCache<Key, Value>>(cap, 2 * cap, 2));
+    }
+    if (name == "hash-lru") {
+        return std::make_unique<
+            ShardedPolicy<Key, Value, IHashLruCaches<Key, Value>>>(capacity,
+                                                                   shards);
+    }
+    if (name == "hash-lru-hot") {
+        // 开启热点键复制的分片 LRU
+        auto policy = std::make_unique<
+            ShardedPolicy<Key, Value, IHashLruCaches<Key, Value>>>(capacity,
+                                                                   shards);
+        policy->cache().enableHotKeyReplication();
+        return policy;
+    }
+    if (name == "lfu") {
+        return std::make_unique<ILfuCache<Key, Value>>(cap);
+    }
+    if (name == "hash-lfu") {
+        return std::make_unique<
+            ShardedPolicy<Key, Value, KHashLfuCache<Key, Value>>>(capacity,
+                                                                  shards);
+    }
+    if (name == "arc") {
+        return std::make_unique<IArcCache<Key, Value>>(capacity);
+    }
+    if (name == "slab-lru") {
+        return std::make_unique<ISlabLruCache<Key, Value>>(cap);
+    }
+    if (name == "bucket-lfu") {
+        return std::make_unique<IBucketLfuCache<Key, Value>>(cap);
+    }
+    if (name == "tiny-lfu") {
+        return std::make_unique<ITinyLfuCache<Key, Value>>(cap);
+    }
+    if (name == "buffered-lru") {
+        return std::make_unique<IBufferedLruCache<Key, Value>>(cap);
+    }
+    if (name == "clock") {
+        return std::make_unique<IClockCache<Key, Value>>(cap);
+    }
+    if (name == "arc-adaptive") {
+        return std::make_unique<IAdaptiveArcCache<Key, Value>>(capacity);
+    }
+    return nullptr;
+}
+
+// 解析以逗号分隔的列表
+inline std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find(',', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (end > begin) {
+            items.push_back(text.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return items;
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// 访问日志读取：通过 mmap 顺序扫描整个文件，逐条产出请求
+//
+// 支持的格式：
+//   text    每行一个键，可选第二列为对象大小（字节），以空白分隔
+//   arc     ARC 论文使用的块访问日志：起始块号 块数 忽略 请求序号，按块展开
+//   umass   UMass/SPC 存储日志 CSV：ASU,LBA,Size,Opcode,Timestamp
+//   twitter Twitter cache-trace CSV：时间戳,键,键大小,值大小,客户端,操作,TTL
+//   oracle  libCacheSim oracleGeneral 二进制格式（每条 24 字节）：
+//           uint32 时间戳, uint64 对象 ID, uint32 大小, int64 下次访问
+//   bin64   连续的小端 uint64 键，大小按 1 计
+
+enum class TraceFormat { Text, Arc, Umass, Twitter, Oracle, Bin64 };
+
+// 解析格式名称，未知名称返回 false
+inline bool parseTraceFormat(const std::string& name, TraceFormat& format) {
+    static const std::pair<const char*, TraceFormat> kFormats[] = {
+        {"text", TraceFormat::Text},       {"arc", TraceFormat::Arc},
+        {"umass", TraceFormat::Umass},     {"twitter", TraceFormat::Twitter},
+        {"oracle", TraceFormat::Oracle},   {"bin64", TraceFormat::Bin64}};
+    for (const auto& item : kFormats) {
+        if (name == item.first) {
+            format = item.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct TraceRequest {
+    uint64_t key;
+    uint32_t size;
+    bool isWrite;  // 写请求直接写入缓存，不计入命中统计
+};
+
+// 只读内存映射文件
+class MappedFile {
+   public:
+    explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("无法打开文件：" + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("无法读取文件信息：" + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("mmap 失败：" + path);
+            }
+            data_ = static_cast<const char*>(addr);
+            // 顺序读取，提示内核提前预读并及时回收已读页
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+   private:
+    const char* data_;
+    size_t size_;
+};
+
+class TraceReader {
+   public:
+    TraceReader(const std::string& path, TraceFormat format)
+        : file_(path),
+          format_(format),
+          pos_(0),
+          pendingKey_(0),
+          pendingBlocks_(0) {}
+
+    // 读取下一条请求，文件结束时返回 false
+    bool next(TraceRequest& request) {
+        if (format_ == TraceFormat::Oracle) {
+            return nextOracle(request);
+        }
+        if (format_ == TraceFormat::Bin64) {
+            return nextBin64(request);
+        }
+        if (format_ == TraceFormat::Arc && pendingBlocks_ > 0) {
+            --pendingBlocks_;
+            request = TraceRequest{++pendingKey_, kBlockSize, false};
+            return true;
+        }
+        std::string_view line;
+        while (nextLine(line)) {
+            if (parseLine(line, request)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 已读取的字节比例，用于显示进度
+    double progress() const {
+        return file_.size() ? static_cast<double>(pos_) / file_.size() : 1.0;
+    }
+
+   private:
+    static constexpr uint32_t kBlockSize = 512;  // arc 日志的块大小
+
+    bool nextLine(std::string_view& line) {
+        const char* data = file_.data();
+        size_t size = file_.size();
+        while (pos_ < size) {
+            const char* begin = data + pos_;
+            const char* end = static_cast<const char*>(
+                std::memchr(begin, '\n', size - pos_));
+            size_t length =
+                end ? static_cast<size_t>(end - begin) : size - pos_;
+            pos_ += length + 1;
+            if (length > 0 && begin[length - 1] == '\r') {
+                --length;
+            }
+            if (length > 0 && begin[0] != '#') {
+                line = std::string_view(begin, length);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 按分隔符切出第 index 列
+    static std::string_view field(std::string_view line, char delimiter,
+                                  size_t index) {
+        size_t begin = 0;
+        for (size_t i = 0; i < index; ++i) {
+            begin = line.find(delimiter, begin);
+            if (begin == std::string_view::npos) {
+                return {};
+            }
+            ++begin;
+        }
+        size_t end = line.find(delimiter, begin);
+        return line.substr(begin, end == std::string_view::npos
+                                      ? std::string_view::npos
+                                      : end - begin);
+    }
+
+    // 按空白切出第 index 列
+    static std::string_view word(std::string_view line, size_t index) {
+        size_t pos = 0;
+        for (size_t i = 0;; ++i) {
+            while (pos < line.size() &&
+                   (line[pos] == ' ' || line[pos] == '\t')) {
+                ++pos;
+            }
+            size_t begin = pos;
+            while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t') {
+                ++pos;
+            }
+            if (begin == pos) {
+                return {};
+            }
+            if (i == index) {
+                return line.substr(begin, pos - begin);
+            }
+        }
+    }
+
+    static uint64_t toNumber(std::string_view text) {
+        uint64_t value = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') {
+                break;
+            }
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+        }
+        return value;
+    }
+
+    static uint64_t hashKey(std::string_view key) {
+        return std::hash<std::string_view>()(key);
+    }
+
+    bool parseLine(std::string_view line, TraceRequest& request) {
+        if (format_ == TraceFormat::Text) {
+            std::string_view key = word(line, 0);
+            std::string_view size = word(line, 1);
+            request.key = hashKey(key);
+            request.size =
+                size.empty() ? 1 : static_cast<uint32_t>(toNumber(size));
+            request.isWrite = false;
+            return true;
+        }
+        if (format_ == TraceFormat::Arc) {
+            uint64_t start = toNumber(word(line, 0));
+            uint64_t blocks = toNumber(word(line, 1));
+            if (blocks == 0) {
+                return false;
+            }
+            request = TraceRequest{start, kBlockSize, false};
+            pendingKey_ = start;
+            pendingBlocks_ = blocks - 1;
+            return true;
+        }
+        if (format_ == TraceFormat::Umass) {
+            uint64_t asu = toNumber(field(line, ',', 0));
+            uint64_t lba = toNumber(field(line, ',', 1));
+            std::string_view opcode = field(line, ',', 3);
+            request.key = (asu << 48) ^ lba;
+            request.size = static_cast<uint32_t>(toNumber(field(line, ',', 2)));
+            request.isWrite =
+                !opcode.empty() && (opcode[0] == 'w' || opcode[0] == 'W');
+            return true;
+        }
+        // twitter
+        std::string_view key = field(line, ',', 1);
+        if (key.empty()) {
+            return false;
+        }
+        std::string_view op = field(line, ',', 5);
+        request.key = hashKey(key);
+        request.size = static_cast<uint32_t>(toNumber(field(line, ',', 2)) +
+                                             toNumber(field(line, ',', 3)));
+        request.isWrite = !(op == "get" || op == "gets");
+        return true;
+    }
+
+    bool nextOracle(TraceRequest& request) {
+        constexpr size_t kRecordSize = 24;
+        if (pos_ + kRecordSize > file_.size()) {
+            return false;
+        }
+        const char* record = file_.data() + pos_;
+        uint64_t id;
+        uint32_t size;
+        std::memcpy(&id, record + 4, sizeof(id));
+        std::memcpy(&size, record + 12, sizeof(size));
+        pos_ += kRecordSize;
+        request = TraceRequest{id, size, false};
+        return true;
+    }
+
+    bool nextBin64(TraceRequest& request) {
+        if (pos_ + sizeof(uint64_t) > file_.size()) {
+            return false;
+        }
+        uint64_t key;
+        std::memcpy(&key, file_.data() + pos_, sizeof(key));
+        pos_ += sizeof(key);
+        request = TraceRequest{key, 1, false};
+        return true;
+    }
+
+   private:
+    MappedFile file_;
+    TraceFormat format_;
+    size_t pos_;              // 当前读取位置
+    uint64_t pendingKey_;     // arc 格式下正在展开的块号
+    uint64_t pendingBlocks_;  // arc 格式下尚未展开的块数
+};
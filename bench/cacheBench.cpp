@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ICacheKey.h"
+#include "../IHashMix.h"
+#include "PolicyFactory.h"
+
+// 多线程吞吐与延迟基准测试：
+// 在可配置的线程数、读写比例和键分布下运行各个缓存策略，
+// 输出每秒操作数、单次操作延迟的 p50/p99/p999 以及相对最少线程数的扩展效率
+//
+// 用法示例：
+//   cache_bench --policies=lru,hash-lru,clock --threads=1,2,4,8
+//               --dist=zipf --theta=0.99 --read=90 --ops=200000
+//
+// --dist=shard-local 时线程 t 只访问落在分片 t % 分片数 上的键，
+// 线程之间没有锁竞争，分片版本的吞吐若不随线程数线性增长，
+// 差距来自分片之间共享缓存行（伪共享）和内存带宽：
+//   cache_bench --policies=hash-lru,hash-lfu --threads=1,8,32,64
+//               --shards=64 --dist=shard-local
+
+struct BenchConfig {
+    std::vector<std::string> policies = {"lru", "lru-k", "hash-lru",
+                                         "lfu", "hash-lfu", "arc"};
+    std::vector<int> threads = {1, 2, 4, 8};
+    size_t capacity = 100000;    // 缓存容量
+    size_t keySpace = 400000;    // 键空间大小
+    size_t operations = 200000;  // 每个线程的操作次数
+    int readPercent = 90;        // 读操作比例
+    std::string distribution = "zipf";  // uniform / zipf / hotspot /
+                                        // shard-local
+    double theta = 0.99;                // zipf 分布的偏斜参数
+    int sampleEvery = 1;                // 每隔多少次操作记录一次延迟
+    int shards = 0;  // 分片版本的分片数，0 表示取硬件线程数
+};
+
+struct Operation {
+    int key;
+    bool isPut;
+};
+
+struct BenchResult {
+    double opsPerSec;
+    double p50;  // 纳秒
+    double p99;
+    double p999;
+};
+
+// YCSB 风格的 zipf 生成器，预先计算 zeta(n) 后每次采样 O(1)
+class ZipfGenerator {
+   public:
+    ZipfGenerator(uint64_t n, double theta)
+        : n_(n), theta_(theta), zetan_(zeta(n, theta)) {
+        alpha_ = 1.0 / (1.0 - theta_);
+        double zeta2 = zeta(2, theta_);
+        eta_ = (1.0 - std::pow(2.0 / n_, 1.0 - theta_)) /
+               (1.0 - zeta2 / zetan_);
+    }
+
+    uint64_t next(std::mt19937_64& gen) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+        double uz = u * zetan_;
+        if (uz < 1.0) {
+            return 0;
+        }
+        if (uz < 1.0 + std::pow(0.5, theta_)) {
+            return 1;
+        }
+        uint64_t rank = static_cast<uint64_t>(
+            n_ * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+        return rank < n_ ? rank : n_ - 1;
+    }
+
+   private:
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return sum;
+    }
+
+    uint64_t n_;
+    double theta_;
+    double zetan_;
+    double alpha_;
+    double eta_;
+};
+
+// 按分片版本的分片选择规则，把键空间划分到各个分片
+std::vector<std::vector<int>> keysByShard(const BenchConfig& config) {
+    size_t shardCount = config.shards > 0
+                            ? config.shards
+                            : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::vector<int>> shards(shardCount);
+    IncreCache::CacheHash<int> hashFunc;
+    for (size_t key = 0; key < config.keySpace; ++key) {
+        size_t hash = hashFunc(static_cast<int>(key));
+        shards[IncreCache::shardOf(IncreCache::mixHash(hash), shardCount)]
+            .push_back(static_cast<int>(key));
+    }
+    return shards;
+}
+
+// 预先生成每个线程的操作序列，避免随机数生成计入被测时间
+std::vector<std::vector<Operation>> generateWorkload(const BenchConfig& config,
+                                                     int threadNum) {
+    std::vector<std::vector<Operation>> workload(threadNum);
+    ZipfGenerator zipf(config.keySpace, config.theta);
+    std::vector<std::vector<int>> shardKeys;
+    if (config.distribution == "shard-local") {
+        shardKeys = keysByShard(config);
+    }
+    for (int t = 0; t < threadNum; ++t) {
+        std::mt19937_64 gen(t + 1);
+        auto& ops = workload[t];
+        ops.reserve(config.operations);
+        for (size_t i = 0; i < config.operations; ++i) {
+            uint64_t key;
+            if (config.distribution == "shard-local") {
+                const auto& keys = shardKeys[t % shardKeys.size()];
+                key = keys.empty() ? 0 : keys[gen() % keys.size()];
+            } else if (config.distribution == "zipf") {
+                key = zipf.next(gen);
+            } else if (config.distribution == "hotspot") {
+                // 80% 的访问集中在 20% 的键上
+                size_t hotKeys = std::max<size_t>(config.keySpace / 5, 1);
+                if (gen() % 100 < 80 || config.keySpace == hotKeys) {
+                    // 键空间太小时没有冷键，全部落在热键上
+                    key = gen() % hotKeys;
+                } else {
+                    key = hotKeys + gen() % (config.keySpace - hotKeys);
+                }
+            } else {
+                key = gen() % config.keySpace;
+            }
+            bool isPut = static_cast<int>(gen() % 100) >= config.readPercent;
+            ops.push_back(Operation{static_cast<int>(key), isPut});
+        }
+    }
+    return workload;
+}
+
+double percentile(std::vector<uint32_t>& samples, double ratio) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(ratio * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+BenchResult runBench(IncreCache::ICachePolicy<int, int>& cache,
+                     const BenchConfig& config,
+                     const std::vector<std::vector<Operation>>& workload) {
+    int threadNum = static_cast<int>(workload.size());
+    std::vector<std::vector<uint32_t>> latencies(threadNum);
+    std::atomic<int> ready{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadNum; ++t) {
+        workers.emplace_back([&, t]() {
+            const auto& ops = workload[t];
+            auto& samples = latencies[t];
+            samples.reserve(ops.size() / config.sampleEvery + 1);
+            ready.fetch_add(1);
+            while (!start.load(std::memory_order_acquire)) {
+            }
+            int value = 0;
+            for (size_t i = 0; i < ops.size(); ++i) {
+                bool sampled = i % config.sampleEvery == 0;
+                auto begin = sampled ? std::chrono::steady_clock::now()
+                                     : std::chrono::steady_clock::time_point();
+                if (ops[i].isPut) {
+                    cache.put(ops[i].key, static_cast<int>(i));
+                } else {
+                    cache.get(ops[i].key, value);
+                }
+                if (sampled) {
+                    auto ns =
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - begin)
+                            .count();
+                    samples.push_back(static_cast<uint32_t>(ns));
+                }
+            }
+        });
+    }
+    while (ready.load() < threadNum) {
+    }
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+
+    std::vector<uint32_t> all;
+    for (auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    BenchResult result;
+    result.opsPerSec =
+        static_cast<double>(threadNum) * config.operations / seconds;
+    result.p50 = percentile(all, 0.50);
+    result.p99 = percentile(all, 0.99);
+    result.p999 = percentile(all, 0.999);
+    return result;
+}
+
+bool parseArgs(int argc, char* argv[], BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::cerr << "无法识别的参数：" << arg << std::endl;
+            return false;
+        }
+        std::string name = arg.substr(2, eq - 2);
+        std::string value = arg.substr(eq + 1);
+        if (name == "policies") {
+            config.policies =
+                value == "all" ? allPolicyNames() : splitList(value);
+        } else if (name == "threads") {
+            config.threads.clear();
+            for (const auto& item : splitList(value)) {
+                config.threads.push_back(std::max(1, std::atoi(item.c_str())));
+            }
+        } else if (name == "capacity") {
+            config.capacity = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "keys") {
+            config.keySpace = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "ops") {
+            config.operations = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "read") {
+            config.readPercent = std::atoi(value.c_str());
+        } else if (name == "dist") {
+            config.distribution = value;
+        } else if (name == "theta") {
+            config.theta = std::atof(value.c_str());
+        } else if (name == "sample") {
+            config.sampleEvery = std::max(1, std::atoi(value.c_str()));
+        } else if (name == "shards") {
+            config.shards = std::max(0, std::atoi(value.c_str()));
+        } else {
+            std::cerr << "未知参数：" << name << std::endl;
+            return false;
+        }
+    }
+    if (config.keySpace == 0 || config.threads.empty()) {
+        std::cerr << "键空间和线程数不能为空" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        return 1;
+    }
+    std::cout << "容量：" << config.capacity << "  键空间：" << config.keySpace
+              << "  分布：" << config.distribution
+              << "  读比例：" << config.readPercent
+              << "%  每线程操作数：" << config.operations << std::endl;
+    std::cout << std::left << std::setw(14) << "policy" << std::right
+              << std::setw(8) << "threads" << std::setw(12) << "Mops/s"
+              << std::setw(10) << "p50(ns)" << std::setw(10) << "p99(ns)"
+              << std::setw(11) << "p999(ns)" << std::setw(10) << "scaling"
+              << std::endl;
+
+    std::vector<std::vector<std::vector<Operation>>> workloads;
+    for (int threadNum : config.threads) {
+        workloads.push_back(generateWorkload(config, threadNum));
+    }
+
+    for (const auto& policy : config.policies) {
+        double baseOpsPerThread = 0;
+        for (size_t i = 0; i < config.threads.size(); ++i) {
+            auto cache =
+                makePolicy<int, int>(policy, config.capacity, config.shards);
+            if (!cache) {
+                std::cerr << "未知策略：" << policy << std::endl;
+                break;
+            }
+            // 预热：先填满缓存，避免冷启动阶段的插入主导测试结果
+            for (size_t key = 0; key < config.capacity; ++key) {
+                cache->put(static_cast<int>(key % config.keySpace),
+                           static_cast<int>(key));
+            }
+            int threadNum = config.threads[i];
+            BenchResult result = runBench(*cache, config, workloads[i]);
+            double opsPerThread = result.opsPerSec / threadNum;
+            if (i == 0) {
+                baseOpsPerThread = opsPerThread;
+            }
+            std::cout << std::left << std::setw(14) << policy << std::right
+                      << std::setw(8) << threadNum << std::fixed
+                      << std::setprecision(2) << std::setw(12)
+                      << result.opsPerSec / 1e6 << std::setprecision(0)
+                      << std::setw(10) << result.p50 << std::setw(10)
+                      << result.p99 << std::setw(11) << result.p999
+                      << std::setprecision(1) << std::setw(9)
+                      << 100.0 * opsPerThread / baseOpsPerThread << "%"
+                      << std::endl;
+        }
+    }
+    return 0;
+}
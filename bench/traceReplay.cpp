@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../IMissRatioCurve.h"
+#include "PolicyFactory.h"
+#include "TraceReader.h"
+
+// 访问日志回放：把真实访问日志顺序喂给各个缓存策略，
+// 输出命中率、字节命中率和回放吞吐。日志只读取一遍，
+// 每读出一批请求就依次交给所有（策略, 容量）组合，便于一次扫描比较多个容量
+//
+// 用法示例：
+//   trace_replay --trace=web.log --format=text --policies=lru,arc-adaptive
+//                --capacities=1000,10000,100000
+//   trace_replay --trace=web.log --policies= --mrc-rate=0.01
+//                --capacities=1000,10000,100000
+
+struct ReplayConfig {
+    std::string tracePath;
+    std::string format = "text";
+    std::vector<std::string> policies = {"lru", "lfu", "arc-adaptive"};
+    std::vector<size_t> capacities = {1000, 10000, 100000};
+    size_t limit = 0;       // 最多回放的请求数，0 表示不限制
+    double mrcRate = 0;     // 缺失率曲线的 SHARDS 采样率，0 表示不计算
+    size_t mrcSamples = 0;  // 缺失率曲线最多跟踪的键数，0 表示不限制
+};
+
+// 一个（策略, 容量）组合的回放状态
+struct ReplayTarget {
+    std::string policy;
+    size_t capacity;
+    PolicyPtr<uint64_t, uint32_t> cache;
+    uint64_t reads = 0;      // 读请求数
+    uint64_t hits = 0;       // 读命中数
+    uint64_t bytes = 0;      // 读请求的总字节数
+    uint64_t hitBytes = 0;   // 读命中的字节数
+    uint64_t requests = 0;   // 回放的请求总数（含写）
+    double seconds = 0;      // 回放耗时，不含日志解析
+};
+
+// 读请求未命中时按 cache-aside 方式回填，写请求直接写入
+void replayBatch(ReplayTarget& target,
+                 const std::vector<TraceRequest>& batch) {
+    auto& cache = *target.cache;
+    uint32_t value = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& request : batch) {
+        if (request.isWrite) {
+            cache.put(request.key, request.size);
+            continue;
+        }
+        ++target.reads;
+        target.bytes += request.size;
+        if (cache.get(request.key, value)) {
+            ++target.hits;
+            target.hitBytes += request.size;
+        } else {
+            cache.put(request.key, request.size);
+        }
+    }
+    target.seconds += std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+    target.requests += batch.size();
+}
+
+bool parseArgs(int argc, char* argv[], ReplayConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::cerr << "无法识别的参数：" << arg << std::endl;
+            return false;
+        }
+        std::string name = arg.substr(2, eq - 2);
+        std::string value = arg.substr(eq + 1);
+        if (name == "trace") {
+            config.tracePath = value;
+        } else if (name == "format") {
+            config.format = value;
+        } else if (name == "policies") {
+            config.policies =
+                value == "all" ? allPolicyNames() : splitList(value);
+        } else if (name == "capacities") {
+            config.capacities.clear();
+            for (const auto& item : splitList(value)) {
+                config.capacities.push_back(
+                    std::strtoull(item.c_str(), nullptr, 10));
+            }
+        } else if (name == "limit") {
+            config.limit = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "mrc-rate") {
+            config.mrcRate = std::atof(value.c_str());
+        } else if (name == "mrc-samples") {
+            config.mrcSamples = std::strtoull(value.c_str(), nullptr, 10);
+        } else {
+            std::cerr << "未知参数：" << name << std::endl;
+            return false;
+        }
+    }
+    if (config.tracePath.empty() || config.capacities.empty()) {
+        std::cerr << "用法：trace_replay --trace=<文件> [--format=text|arc|"
+                     "umass|twitter|oracle|bin64] [--policies=lru,...] "
+                     "[--capacities=1000,...] [--limit=N] [--mrc-rate=R] "
+                     "[--mrc-samples=N]"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ReplayConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        return 1;
+    }
+    TraceFormat format;
+    if (!parseTraceFormat(config.format, format)) {
+        std::cerr << "未知的日志格式：" << config.format << std::endl;
+        return 1;
+    }
+
+    std::vector<ReplayTarget> targets;
+    for (const auto& policy : config.policies) {
+        for (size_t capacity : config.capacities) {
+            ReplayTarget target;
+            target.policy = policy;
+            target.capacity = capacity;
+            target.cache = makePolicy<uint64_t, uint32_t>(policy, capacity);
+            if (!target.cache) {
+                std::cerr << "未知策略：" << policy << std::endl;
+                return 1;
+            }
+            targets.push_back(std::move(target));
+        }
+    }
+
+    // 缺失率曲线与各策略共用同一次日志扫描
+    bool computeMrc = config.mrcRate > 0 || config.mrcSamples > 0;
+    IncreCache::MissRatioCurve mrc(config.mrcRate > 0 ? config.mrcRate : 1.0,
+                                   config.mrcSamples);
+
+    uint64_t total = 0;
+    try {
+        TraceReader reader(config.tracePath, format);
+        // 按批回放：一批请求留在 CPU 缓存中供所有组合复用，
+        // 日志解析只做一次，且不计入各策略的耗时
+        constexpr size_t kBatchSize = 1 << 16;
+        std::vector<TraceRequest> batch;
+        batch.reserve(kBatchSize);
+        TraceRequest request;
+        bool more = true;
+        while (more) {
+            batch.clear();
+            while (batch.size() < kBatchSize &&
+                   (config.limit == 0 || total < config.limit)) {
+                if (!reader.next(request)) {
+                    break;
+                }
+                batch.push_back(request);
+                ++total;
+            }
+            more = batch.size() == kBatchSize &&
+                   (config.limit == 0 || total < config.limit);
+            for (auto& target : targets) {
+                replayBatch(target, batch);
+            }
+            if (computeMrc) {
+                for (const auto& item : batch) {
+                    mrc.accessHash(IncreCache::mixHash(item.key));
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "日志：" << config.tracePath << "  格式：" << config.format
+              << "  请求数：" << total << std::endl;
+    std::cout << std::left << std::setw(14) << "policy" << std::right
+              << std::setw(12) << "capacity" << std::setw(12) << "hit%"
+              << std::setw(12) << "byteHit%" << std::setw(12) << "Mops/s"
+              << std::endl;
+    for (const auto& target : targets) {
+        double hitRatio =
+            target.reads ? 100.0 * target.hits / target.reads : 0.0;
+        double byteHitRatio =
+            target.bytes ? 100.0 * target.hitBytes / target.bytes : 0.0;
+        double mops =
+            target.seconds > 0 ? target.requests / target.seconds / 1e6 : 0.0;
+        std::cout << std::left << std::setw(14) << target.policy << std::right
+                  << std::setw(12) << target.capacity << std::fixed
+                  << std::setprecision(2) << std::setw(12) << hitRatio
+                  << std::setw(12) << byteHitRatio << std::setw(12) << mops
+                  << std::endl;
+    }
+
+    if (computeMrc) {
+        std::vector<size_t> sizes = config.capacities;
+        std::sort(sizes.begin(), sizes.end());
+        std::vector<double> ratios = mrc.curve(sizes);
+        std::cout << "\nLRU 缺失率曲线（采样率 " << std::fixed
+                  << std::setprecision(4) << mrc.samplingRate()
+                  << "，跟踪键数 " << mrc.trackedKeys() << "）" << std::endl;
+        std::cout << std::setw(12) << "capacity" << std::setw(12) << "miss%"
+                  << std::endl;
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            std::cout << std::setw(12) << sizes[i] << std::setprecision(2)
+                      << std::setw(12) << 100.0 * ratios[i] << std::endl;
+        }
+    }
+    return 0;
+}
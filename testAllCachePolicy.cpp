@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -6,10 +7,13 @@
 #include <string>
 #include <vector>
 
+#include "IArcCache/IAdaptiveArcCache.h"
 #include "IArcCache/IArcCache.h"
 #include "ICachePolicy.h"
 #include "ILfuCache.h"
 #include "ILruCache.h"
+#include "IMissRatioCurve.h"
+#include "ITinyLfuCache.h"
 
 class Timer {
    public:
@@ -28,21 +32,12 @@ class Timer {
 
 // 辅助函数：打印结果
 void printResults(const std::string& testName, int capacity,
+                  const std::vector<std::string>& names,
                   const std::vector<int>& get_operations,
                   const std::vector<int>& hits) {
     std::cout << "===" << testName << " 结果汇总 === " << std::endl;
     std::cout << "缓存大小：" << capacity << std::endl;
 
-    // 假设对应的算法名称已在测试函数中定义
-    std::vector<std::string> names;
-    if (hits.size() == 3) {
-        names = {"LRU", "LFU", "ARC"};
-    } else if (hits.size() == 4) {
-        names = {"LRU", "LFU", "ARC", "LRU-K"};
-    } else if (hits.size() == 5) {
-        names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
-    }
-
     for (size_t i = 0; i < hits.size(); ++i) {
         double hitRate = 100.0 * hits[i] / get_operations[i];
         std::cout << (i < names.size() ? names[i]
@@ -56,6 +51,20 @@ void printResults(const std::string& testName, int capacity,
     std::cout << std::endl;  // 添加空行，使输出更清晰
 }
 
+// 辅助函数：打印同一访问序列（读写都计入）在不同容量下的 LRU 缺失率曲线
+void printMissRatioCurve(const std::string& testName,
+                         const IncreCache::MissRatioCurve& mrc,
+                         const std::vector<size_t>& sizes) {
+    std::cout << "===" << testName << " LRU 缺失率曲线 === " << std::endl;
+    std::vector<double> ratios = mrc.curve(sizes);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        std::cout << "容量 " << sizes[i] << " - 缺失率：" << std::fixed
+                  << std::setprecision(2) << 100.0 * ratios[i] << "%"
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
 void testHotDataAccess() {
     std::cout << "\n=== 测试场景1:热点数据访问测试===" << std::endl;
 
@@ -75,20 +84,25 @@ void testHotDataAccess() {
     IncreCache::ILruKCache<int, std::string> lruk(CAPACITY,
                                                   HOT_KEYS + COLD_KEYS, 2);
     IncreCache::ILfuCache<int, std::string> lfuAging(CAPACITY, 20000);
+    IncreCache::ITinyLfuCache<int, std::string> tinyLfu(CAPACITY);
+    IncreCache::IAdaptiveArcCache<int, std::string> adaptiveArc(CAPACITY);
 
     std::random_device rd;
     std::mt19937 gen(rd());
 
-    // 基类指针指向派生类对象，添加 LFU-Aging
-    std::array<IncreCache::ICachePolicy<int, std::string>*, 5> caches = {
-        &lru, &lfu, &arc, &lruk, &lfuAging};
-    std::vector<int> hits(5, 0);
-    std::vector<int> get_operations(5, 0);
-    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K",
-                                      "LFU-Aging"};
+    // 基类指针指向派生类对象，添加 LFU-Aging、W-TinyLFU 和自适应 ARC
+    std::array<IncreCache::ICachePolicy<int, std::string>*, 7> caches = {
+        &lru, &lfu, &arc, &lruk, &lfuAging, &tinyLfu, &adaptiveArc};
+    std::vector<int> hits(7, 0);
+    std::vector<int> get_operations(7, 0);
+    std::vector<std::string> names = {"LRU",       "LFU",       "ARC",
+                                      "LRU-K",     "LFU-Aging", "W-TinyLFU",
+                                      "ARC-Adaptive"};
+    // 用第一个缓存的访问序列一次性计算所有容量下的 LRU 缺失率
+    IncreCache::MissRatioCurve mrc;
 
     // 为所有的缓存对象进行相同的操作序列测试
-    for (int i = 0; i < caches.size(); ++i) {
+    for (size_t i = 0; i < caches.size(); ++i) {
         // 先预热缓存，插入一些数据
         for (int key = 0; key < HOT_KEYS; ++key) {
             std::string value = "value" + std::to_string(key);
@@ -108,6 +122,10 @@ void testHotDataAccess() {
                 key = HOT_KEYS + (gen() % COLD_KEYS);  // 冷数据
             }
 
+            if (i == 0) {
+                mrc.access(key);
+            }
+
             if (isPut) {
                 // 执行 put 操作
                 std::string value = "value" + std::to_string(key) + "_v" +
@@ -124,7 +142,9 @@ void testHotDataAccess() {
         }
     }
     // 打印测试结果
-    printResults("热点数据访问测试", CAPACITY, get_operations, hits);
+    printResults("热点数据访问测试", CAPACITY, names, get_operations, hits);
+    printMissRatioCurve("热点数据访问测试", mrc,
+                        {5, 10, CAPACITY, 40, 80, 160, 1000});
 }
 
 void testLoopPattern() {
@@ -143,20 +163,25 @@ void testLoopPattern() {
     // - k = 2：对于循环访问，这是一个合理的阈值
     IncreCache::ILruKCache<int, std::string> lruk(CAPACITY, LOOP_SIZE * 2, 2);
     IncreCache::ILfuCache<int, std::string> lfuAging(CAPACITY, 3000);
+    IncreCache::ITinyLfuCache<int, std::string> tinyLfu(CAPACITY);
+    IncreCache::IAdaptiveArcCache<int, std::string> adaptiveArc(CAPACITY);
 
     std::random_device rd;
     std::mt19937 gen(rd());
 
-    // 基类指针指向派生类对象，添加 LFU-Aging
-    std::array<IncreCache::ICachePolicy<int, std::string>*, 5> caches = {
-        &lru, &lfu, &arc, &lruk, &lfuAging};
-    std::vector<int> hits(5, 0);
-    std::vector<int> get_operations(5, 0);
-    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K",
-                                      "LFU-Aging"};
+    // 基类指针指向派生类对象，添加 LFU-Aging、W-TinyLFU 和自适应 ARC
+    std::array<IncreCache::ICachePolicy<int, std::string>*, 7> caches = {
+        &lru, &lfu, &arc, &lruk, &lfuAging, &tinyLfu, &adaptiveArc};
+    std::vector<int> hits(7, 0);
+    std::vector<int> get_operations(7, 0);
+    std::vector<std::string> names = {"LRU",       "LFU",       "ARC",
+                                      "LRU-K",     "LFU-Aging", "W-TinyLFU",
+                                      "ARC-Adaptive"};
+    // 用第一个缓存的访问序列一次性计算所有容量下的 LRU 缺失率
+    IncreCache::MissRatioCurve mrc;
 
     // 为每种缓存算法进行相同的测试
-    for (int i = 0; i < caches.size(); ++i) {
+    for (size_t i = 0; i < caches.size(); ++i) {
         // 先预热一部分数据（只加载 20% 的数据）
         for (int key = 0; key < LOOP_SIZE / 5; ++key) {
             std::string value = "loop" + std::to_string(key);
@@ -181,6 +206,10 @@ void testLoopPattern() {
                 key = LOOP_SIZE + (gen() % LOOP_SIZE);
             }
 
+            if (i == 0) {
+                mrc.access(key);
+            }
+
             if (isPut) {
                 // 执行 put 操作，更新数据
                 std::string value = "loop" + std::to_string(key) + "_v" +
@@ -196,7 +225,9 @@ void testLoopPattern() {
             }
         }
     }
-    printResults("循环扫描测试", CAPACITY, get_operations, hits);
+    printResults("循环扫描测试", CAPACITY, names, get_operations, hits);
+    printMissRatioCurve("循环扫描测试", mrc,
+                        {10, 25, CAPACITY, 100, 250, 500, 1000});
 }
 
 void testWorkloadShift() {
@@ -211,20 +242,25 @@ void testWorkloadShift() {
     IncreCache::IArcCache<int, std::string> arc(CAPACITY);
     IncreCache::ILruKCache<int, std::string> lruk(CAPACITY, 500, 2);
     IncreCache::ILfuCache<int, std::string> lfuAging(CAPACITY, 10000);
+    IncreCache::ITinyLfuCache<int, std::string> tinyLfu(CAPACITY);
+    IncreCache::IAdaptiveArcCache<int, std::string> adaptiveArc(CAPACITY);
 
     std::random_device rd;
     std::mt19937 gen(rd());
 
-    // 基类指针指向派生类对象，添加 LFU-Aging
-    std::array<IncreCache::ICachePolicy<int, std::string>*, 5> caches = {
-        &lru, &lfu, &arc, &lruk, &lfuAging};
-    std::vector<int> hits(5, 0);
-    std::vector<int> get_operations(5, 0);
-    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K",
-                                      "LFU-Aging"};
+    // 基类指针指向派生类对象，添加 LFU-Aging、W-TinyLFU 和自适应 ARC
+    std::array<IncreCache::ICachePolicy<int, std::string>*, 7> caches = {
+        &lru, &lfu, &arc, &lruk, &lfuAging, &tinyLfu, &adaptiveArc};
+    std::vector<int> hits(7, 0);
+    std::vector<int> get_operations(7, 0);
+    std::vector<std::string> names = {"LRU",       "LFU",       "ARC",
+                                      "LRU-K",     "LFU-Aging", "W-TinyLFU",
+                                      "ARC-Adaptive"};
+    // 用第一个缓存的访问序列一次性计算所有容量下的 LRU 缺失率
+    IncreCache::MissRatioCurve mrc;
 
     // 为每种缓存算法进行相同的测试
-    for (int i = 0; i < caches.size(); ++i) {
+    for (size_t i = 0; i < caches.size(); ++i) {
         // 先预热缓存，只插入少量初始数据
         for (int key = 0; key < 30; ++key) {
             std::string value = "init" + std::to_string(key);
@@ -286,6 +322,9 @@ void testWorkloadShift() {
                     key = 50 + (gen() % 350);  // 大范围也相应缩小
                 }
             }
+            if (i == 0) {
+                mrc.access(key);
+            }
             if (isPut) {
                 // 执行写操作
                 std::string value = "value" + std::to_string(key) + "_p" +
@@ -301,7 +340,10 @@ void testWorkloadShift() {
             }
         }
     }
-    printResults("工作负载剧烈变化测试", CAPACITY, get_operations, hits);
+    printResults("工作负载剧烈变化测试", CAPACITY, names, get_operations,
+                 hits);
+    printMissRatioCurve("工作负载剧烈变化测试", mrc,
+                        {10, 20, CAPACITY, 60, 100, 200, 400});
 }
 
 int main() {
@@ -0,0 +1,84 @@
+#include <random>
+
+#include "../IArcCache/IAdaptiveArcCache.h"
+#include "testUtil.h"
+
+using IncreCache::IAdaptiveArcCache;
+
+namespace {
+using Cache = IAdaptiveArcCache<int, int>;
+
+void checkInvariants(Cache& cache, size_t capacity) {
+    Cache::ListSizes sizes = cache.listSizes();
+    CHECK(sizes.t1 + sizes.t2 <= capacity);
+    CHECK(sizes.t1 + sizes.b1 <= capacity);
+    CHECK(sizes.t1 + sizes.t2 + sizes.b1 + sizes.b2 <= 2 * capacity);
+    CHECK(sizes.target <= capacity);
+}
+
+// 随机读写下每次操作之后都满足论文中的不变式
+void testInvariantsUnderRandomLoad() {
+    const size_t capacity = 16;
+    Cache cache(capacity);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> keyDist(0, 63);
+    for (int op = 0; op < 20000; ++op) {
+        int key = keyDist(gen);
+        if (gen() % 3 == 0) {
+            cache.put(key, key);
+        } else {
+            int value = 0;
+            if (cache.tryGet(key, value)) {
+                CHECK(value == key);
+            }
+        }
+        checkInvariants(cache, capacity);
+    }
+}
+
+// 按固定顺序构造 B1 和 B2 的幽灵命中：
+// B1 命中增大 p，B2 命中减小 p，两种命中都把键放进 T2
+void testGhostHitsAdaptTarget() {
+    Cache cache(4);
+    int value = 0;
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.tryGet(1, value);  // 1、2 进入 T2
+    cache.tryGet(2, value);
+    cache.put(3, 3);
+    cache.put(4, 4);
+    cache.put(5, 5);  // T1 超过 p = 0，淘汰 3 进入 B1
+
+    Cache::ListSizes sizes = cache.listSizes();
+    CHECK(sizes.t1 == 2 && sizes.t2 == 2 && sizes.b1 == 1 && sizes.b2 == 0);
+    CHECK(sizes.target == 0);
+    CHECK(!cache.tryGet(3, value));
+
+    cache.put(3, 30);  // B1 幽灵命中：p 增大，淘汰 T1 中的 4，3 进入 T2
+    sizes = cache.listSizes();
+    CHECK(sizes.target == 1);
+    CHECK(sizes.t1 == 1 && sizes.t2 == 3 && sizes.b1 == 1 && sizes.b2 == 0);
+    checkInvariants(cache, 4);
+
+    cache.put(6, 6);  // T1 不超过 p = 1，淘汰 T2 最久未访问的 1 进入 B2
+    sizes = cache.listSizes();
+    CHECK(sizes.t1 == 2 && sizes.t2 == 2 && sizes.b2 == 1);
+    CHECK(!cache.tryGet(1, value));
+
+    cache.put(1, 10);  // B2 幽灵命中：p 减小，淘汰 T1 中的 5，1 进入 T2
+    sizes = cache.listSizes();
+    CHECK(sizes.target == 0);
+    CHECK(sizes.t1 == 1 && sizes.t2 == 3 && sizes.b1 == 2 && sizes.b2 == 0);
+    checkInvariants(cache, 4);
+
+    CHECK(cache.tryGet(1, value) && value == 10);
+    CHECK(cache.tryGet(3, value) && value == 30);
+    CHECK(cache.stats().ghostHits == 2);
+}
+}  // namespace
+
+int main() {
+    testInvariantsUnderRandomLoad();
+    testGhostHitsAdaptTarget();
+    return IncreCacheTest::report("adaptiveArcTest");
+}
@@ -0,0 +1,124 @@
+#include <string>
+#include <string_view>
+
+#include "../ICacheKey.h"
+#include "../IFlatIndex.h"
+#include "../ILruCache.h"
+#include "testUtil.h"
+
+using IncreCache::CacheHash;
+using IncreCache::CacheKeyEqual;
+using IncreCache::FlatIndex;
+
+namespace {
+// 所有键哈希到同一组，用来构造整组占满、必须留下删除标记的情况
+struct CollidingHash {
+    size_t operator()(int) const { return 0; }
+};
+
+using IntIndex = FlatIndex<int, int, CacheHash<int>, CacheKeyEqual<int>>;
+using CollidingIndex = FlatIndex<int, int, CollidingHash, std::equal_to<int>>;
+using StringIndex = FlatIndex<std::string, std::string, CacheHash<std::string>,
+                              CacheKeyEqual<std::string>>;
+
+void testEmplaceFindErase() {
+    IntIndex index;
+    CHECK(index.find(1) == index.end());
+    CHECK(index.emplace(1, 10).second);
+    CHECK(!index.emplace(1, 11).second);
+    CHECK(index.find(1)->second == 10);
+    index[2] = 20;
+    CHECK(index.size() == 2);
+
+    CHECK(index.erase(1) == 1);
+    CHECK(index.erase(1) == 0);
+    CHECK(index.find(1) == index.end());
+    CHECK(index.find(2)->second == 20);
+
+    index.erase(index.find(2));
+    CHECK(index.empty());
+}
+
+// 删除整组已满的槽位留下删除标记，探测越过它仍能找到后面的键；
+// 之后的插入复用删除标记，反复删除和插入不会触发重新散列
+void testTombstoneReuse() {
+    CollidingIndex index;
+    for (int i = 0; i < 20; ++i) {
+        index.emplace(i, i);
+    }
+    // 起始组已满，键 19 落在探测序列的下一组
+    CHECK(index.erase(0) == 1);
+    CHECK(index.find(0) == index.end());
+    CHECK(index.find(19) != index.end() && index.find(19)->second == 19);
+
+    // 重新散列会移动所有元素，元素地址不变说明没有重新散列
+    const int* stable = &index.find(19)->second;
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(index.emplace(100 + i, i).second);
+        CHECK(index.erase(100 + i) == 1);
+    }
+    CHECK(&index.find(19)->second == stable);
+    CHECK(index.size() == 19);
+    for (int i = 1; i < 20; ++i) {
+        CHECK(index.find(i) != index.end() && index.find(i)->second == i);
+    }
+}
+
+// 持续插入触发多次扩容，每次重新散列后所有元素仍可查到
+void testRehashUnderGrowth() {
+    StringIndex index;
+    const int count = 10000;
+    for (int i = 0; i < count; ++i) {
+        index.emplace(std::to_string(i), "value" + std::to_string(i));
+        if ((i & (i + 1)) == 0) {
+            // 每到 2 的幂检查一次之前插入的全部元素
+            for (int j = 0; j <= i; ++j) {
+                auto it = index.find(std::to_string(j));
+                CHECK(it != index.end() &&
+                      it->second == "value" + std::to_string(j));
+            }
+        }
+    }
+    CHECK(index.size() == static_cast<size_t>(count));
+    for (int i = 0; i < count; i += 2) {
+        CHECK(index.erase(std::to_string(i)) == 1);
+    }
+    CHECK(index.size() == static_cast<size_t>(count / 2));
+    for (int i = 0; i < count; ++i) {
+        bool found = index.find(std::to_string(i)) != index.end();
+        CHECK(found == (i % 2 == 1));
+    }
+    index.clear();
+    CHECK(index.empty());
+    CHECK(index.find("1") == index.end());
+}
+
+// std::string 键用 std::string_view 和 const char* 查找和删除
+void testHeterogeneousLookup() {
+    StringIndex index;
+    index.emplace("alpha", "1");
+    index.emplace("beta", "2");
+    std::string_view alpha = "alpha";
+    CHECK(index.find(alpha) != index.end() && index.find(alpha)->second == "1");
+    CHECK(index.find("beta") != index.end());
+    CHECK(index.find(std::string_view("gamma")) == index.end());
+    CHECK(index.erase(std::string_view("beta")) == 1);
+    CHECK(index.find("beta") == index.end());
+
+    // 策略的索引在两种实现下都接受 std::string_view
+    IncreCache::ILruCache<std::string, int> cache(4);
+    cache.put("key", 1);
+    int value = 0;
+    CHECK(cache.tryGet(std::string_view("key"), value) && value == 1);
+    cache.remove(std::string_view("key"));
+    CHECK(!cache.tryGet(std::string_view("key"), value));
+}
+}  // namespace
+
+int main() {
+    testEmplaceFindErase();
+    testTombstoneReuse();
+    testRehashUnderGrowth();
+    testHeterogeneousLookup();
+    return IncreCacheTest::report("flatIndexTest");
+}
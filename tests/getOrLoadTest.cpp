@@ -0,0 +1,185 @@
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../IArcCache/IAdaptiveArcCache.h"
+#include "../IArcCache/IArcCache.h"
+#include "../IBucketLfuCache.h"
+#include "../IBufferedLruCache.h"
+#include "../IClockCache.h"
+#include "../ILfuCache.h"
+#include "../ILruCache.h"
+#include "../ISlabLruCache.h"
+#include "../ITinyLfuCache.h"
+#include "testUtil.h"
+
+using namespace IncreCache;
+
+namespace {
+constexpr int kThreads = 8;
+constexpr auto kLoadTime = std::chrono::milliseconds(50);
+
+// 命中、加载和 loaded 标志；一次加载只计一次未命中
+template <typename Cache>
+void testLoadedFlag() {
+    Cache cache(16);
+    int calls = 0;
+    auto loader = [&calls](const int& key) {
+        ++calls;
+        return "value" + std::to_string(key);
+    };
+    bool loaded = false;
+    CHECK(cache.getOrLoad(1, loader, loaded) == "value1");
+    CHECK(loaded);
+    CHECK(calls == 1);
+    CacheStats stats = cache.stats();
+    CHECK(stats.misses == 1 && stats.hits == 0);
+
+    CHECK(cache.getOrLoad(1, loader, loaded) == "value1");
+    CHECK(!loaded);
+    CHECK(calls == 1);
+    stats = cache.stats();
+    CHECK(stats.misses == 1 && stats.hits == 1);
+
+    // 已缓存的值不会被 loader 覆盖
+    cache.put(2, "cached");
+    CHECK(cache.getOrLoad(2, loader, loaded) == "cached");
+    CHECK(!loaded);
+    CHECK(calls == 1);
+}
+
+// 同一个键的并发未命中只执行一次 loader，恰好一个调用方的 loaded 为 true
+template <typename Cache>
+void testConcurrentLoadRunsOnce() {
+    Cache cache(16);
+    std::atomic<int> calls{0};
+    std::atomic<int> loadedCount{0};
+    std::latch start(kThreads);
+    std::vector<std::string> results(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            start.arrive_and_wait();
+            bool loaded = false;
+            results[t] = cache.getOrLoad(
+                7,
+                [&calls](const int&) {
+                    calls.fetch_add(1);
+                    std::this_thread::sleep_for(kLoadTime);
+                    return std::string("seven");
+                },
+                loaded);
+            if (loaded) {
+                loadedCount.fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(calls.load() == 1);
+    CHECK(loadedCount.load() == 1);
+    for (const auto& result : results) {
+        CHECK(result == "seven");
+    }
+    // 每个调用方只计一次命中或未命中，加载前的再次检查不重复计数
+    CacheStats stats = cache.stats();
+    CHECK(stats.hits + stats.misses == kThreads);
+    std::string value;
+    CHECK(cache.get(7, value) && value == "seven");
+}
+
+// loader 的异常传给每个调用方，失败的结果不写入缓存
+template <typename Cache>
+void testLoaderExceptionReachesWaiters() {
+    Cache cache(16);
+    std::atomic<int> failures{0};
+    std::atomic<int> loadedCount{0};
+    std::latch start(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            start.arrive_and_wait();
+            bool loaded = false;
+            try {
+                cache.getOrLoad(
+                    9,
+                    [](const int&) -> std::string {
+                        std::this_thread::sleep_for(kLoadTime);
+                        throw std::runtime_error("load failed");
+                    },
+                    loaded);
+            } catch (const std::runtime_error&) {
+                failures.fetch_add(1);
+            }
+            if (loaded) {
+                loadedCount.fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(failures.load() == kThreads);
+    CHECK(loadedCount.load() == 0);
+    std::string value;
+    CHECK(!cache.get(9, value));
+
+    // 失败之后重新加载成功
+    bool loaded = false;
+    CHECK(cache.getOrLoad(
+              9, [](const int&) { return std::string("nine"); }, loaded) ==
+          "nine");
+    CHECK(loaded);
+}
+
+template <typename Cache>
+void testPolicy() {
+    testLoadedFlag<Cache>();
+    testConcurrentLoadRunsOnce<Cache>();
+    testLoaderExceptionReachesWaiters<Cache>();
+}
+
+// 分片版本由 key 所在的分片合并加载
+void testShardedLoadRunsOnce() {
+    IHashLruCaches<int, std::string> cache(64, 4);
+    std::atomic<int> calls{0};
+    std::latch start(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            start.arrive_and_wait();
+            CHECK(cache.getOrLoad(3, [&calls](const int&) {
+                calls.fetch_add(1);
+                std::this_thread::sleep_for(kLoadTime);
+                return std::string("three");
+            }) == "three");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(calls.load() == 1);
+    // 每个调用方只计一次命中或未命中
+    CacheStats stats = cache.stats();
+    CHECK(stats.hits + stats.misses == kThreads);
+}
+}  // namespace
+
+int main() {
+    testPolicy<ILruCache<int, std::string>>();
+    testPolicy<ILfuCache<int, std::string>>();
+    testPolicy<ISlabLruCache<int, std::string>>();
+    testPolicy<IBucketLfuCache<int, std::string>>();
+    testPolicy<IClockCache<int, std::string>>();
+    testPolicy<IBufferedLruCache<int, std::string>>();
+    testPolicy<ITinyLfuCache<int, std::string>>();
+    testPolicy<IArcCache<int, std::string>>();
+    testPolicy<IAdaptiveArcCache<int, std::string>>();
+    testShardedLoadRunsOnce();
+    return IncreCacheTest::report("getOrLoadTest");
+}
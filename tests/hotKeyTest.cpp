@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../ILruCache.h"
+#include "testUtil.h"
+
+using namespace IncreCache;
+
+namespace {
+constexpr int kHotKey = 42;
+constexpr int kPromoteReads = 20000;  // 足够多次采样和刷新，使热点键被复制
+
+using Cache = IHashLruCaches<int, int>;
+
+bool isReplicated(Cache& cache, int key) {
+    std::vector<int> keys = cache.hotKeys();
+    return std::find(keys.begin(), keys.end(), key) != keys.end();
+}
+
+// 反复读取 key，每次都必须读到 expected
+void readHot(Cache& cache, int key, int expected) {
+    for (int i = 0; i < kPromoteReads; ++i) {
+        int value = -1;
+        CHECK(cache.tryGet(key, value));
+        CHECK(value == expected);
+    }
+}
+
+// 热点键被复制之后覆盖写入、再删除，tryGet 都不会从副本读到旧值
+void testOverwriteAndRemoveAfterPromotion() {
+    Cache cache(64, 4);
+    cache.enableHotKeyReplication();
+    for (int key = 0; key < 32; ++key) {
+        cache.put(key, key);
+    }
+    cache.put(kHotKey, 1);
+    readHot(cache, kHotKey, 1);
+    CHECK(isReplicated(cache, kHotKey));
+
+    cache.put(kHotKey, 2);
+    readHot(cache, kHotKey, 2);
+    // 覆盖之后继续读取，键以新结点重新被复制
+    CHECK(isReplicated(cache, kHotKey));
+
+    cache.insertOrAssign(kHotKey, 3, std::chrono::milliseconds(0));
+    readHot(cache, kHotKey, 3);
+
+    cache.remove(kHotKey);
+    for (int i = 0; i < kPromoteReads; ++i) {
+        int value = -1;
+        CHECK(!cache.tryGet(kHotKey, value));
+    }
+    CHECK(!isReplicated(cache, kHotKey));
+
+    // 删除之后重新写入，读到的是新值
+    cache.put(kHotKey, 4);
+    readHot(cache, kHotKey, 4);
+}
+
+// 并发读取热点键时覆盖写入：写入完成之后开始的读取不会读到更早的版本
+void testConcurrentOverwrite() {
+    Cache cache(64, 4);
+    cache.enableHotKeyReplication();
+    cache.put(kHotKey, 0);
+    readHot(cache, kHotKey, 0);
+
+    std::atomic<int> committed{0};  // 已完成写入的最新版本
+    std::atomic<bool> done{false};
+    std::atomic<int> staleReads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                int floor = committed.load();
+                int value = -1;
+                if (!cache.tryGet(kHotKey, value) || value < floor) {
+                    staleReads.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int version = 1; version <= 500; ++version) {
+        cache.put(kHotKey, version);
+        committed.store(version);
+        std::this_thread::yield();
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    CHECK(staleReads.load() == 0);
+}
+}  // namespace
+
+int main() {
+    testOverwriteAndRemoveAfterPromotion();
+    testConcurrentOverwrite();
+    return IncreCacheTest::report("hotKeyTest");
+}
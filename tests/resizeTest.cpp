@@ -0,0 +1,119 @@
+#include <string>
+
+#include "../IArcCache/IAdaptiveArcCache.h"
+#include "../IArcCache/IArcCache.h"
+#include "../IBucketLfuCache.h"
+#include "../IBufferedLruCache.h"
+#include "../IClockCache.h"
+#include "../ILfuCache.h"
+#include "../ILruCache.h"
+#include "../ISlabLruCache.h"
+#include "../ITinyLfuCache.h"
+#include "testUtil.h"
+
+using namespace IncreCache;
+
+namespace {
+constexpr int kInitialCapacity = 64;
+constexpr int kShrunkCapacity = 8;
+constexpr int kGrownCapacity = 512;
+constexpr int kNewKeys = 100;
+
+// 先写满再缩容：setCapacity 只淘汰一批，之后的写入分批淘汰其余的超额条目，
+// 足够多次操作之后条目数回到新容量以内，期间已缓存的值保持正确；
+// 再扩容，之后写入的键全部保留。
+// entriesPerUnit 为每单位容量可容纳的条目数，IArcCache 的两个部分各有
+// capacity 个条目，为 2
+template <typename Cache>
+void testShrinkThenGrow(Cache& cache, const char* name,
+                        size_t entriesPerUnit = 1) {
+    for (int key = 0; key < 4 * kInitialCapacity; ++key) {
+        cache.put(key, key);
+    }
+    CHECK(cache.stats().size <= entriesPerUnit * kInitialCapacity);
+
+    cache.setCapacity(kShrunkCapacity);
+    CHECK(cache.capacity() == kShrunkCapacity);
+    // 每次至多淘汰 kResizeEvictionStep 个，这些写入足以淘汰完
+    for (int n = 0; n < kInitialCapacity; ++n) {
+        cache.put(1000 + n % kShrunkCapacity, n);
+    }
+    size_t shrunk = cache.stats().size;
+    if (shrunk > entriesPerUnit * kShrunkCapacity) {
+        std::cerr << name << ": 缩容后条目数 " << shrunk << std::endl;
+    }
+    CHECK(shrunk <= entriesPerUnit * kShrunkCapacity);
+    for (int key = 0; key < 4 * kInitialCapacity; ++key) {
+        int value = -1;
+        if (cache.get(key, value)) {
+            CHECK(value == key);
+        }
+    }
+
+    cache.setCapacity(kGrownCapacity);
+    CHECK(cache.capacity() == kGrownCapacity);
+    for (int key = 2000; key < 2000 + kNewKeys; ++key) {
+        cache.put(key, key);
+    }
+    int kept = 0;
+    for (int key = 2000; key < 2000 + kNewKeys; ++key) {
+        int value = -1;
+        if (cache.get(key, value) && value == key) {
+            ++kept;
+        }
+    }
+    if (kept != kNewKeys) {
+        std::cerr << name << ": 扩容后保留 " << kept << " 个新键" << std::endl;
+    }
+    CHECK(kept == kNewKeys);
+    CHECK(cache.stats().size <= entriesPerUnit * kGrownCapacity);
+}
+}  // namespace
+
+int main() {
+    {
+        ILruCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "ILruCache");
+    }
+    {
+        IHashLruCaches<int, int> cache(kInitialCapacity, 4);
+        testShrinkThenGrow(cache, "IHashLruCaches");
+    }
+    {
+        ILfuCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "ILfuCache");
+    }
+    {
+        KHashLfuCache<int, int> cache(kInitialCapacity, 4);
+        testShrinkThenGrow(cache, "KHashLfuCache");
+    }
+    {
+        ISlabLruCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "ISlabLruCache");
+    }
+    {
+        IBucketLfuCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "IBucketLfuCache");
+    }
+    {
+        IClockCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "IClockCache");
+    }
+    {
+        ITinyLfuCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "ITinyLfuCache");
+    }
+    {
+        IAdaptiveArcCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "IAdaptiveArcCache");
+    }
+    {
+        IBufferedLruCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "IBufferedLruCache");
+    }
+    {
+        IArcCache<int, int> cache(kInitialCapacity);
+        testShrinkThenGrow(cache, "IArcCache", 2);
+    }
+    return IncreCacheTest::report("resizeTest");
+}
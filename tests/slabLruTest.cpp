@@ -0,0 +1,118 @@
+#include <memory>
+#include <set>
+
+#include "../ISlabLruCache.h"
+#include "testUtil.h"
+
+using IncreCache::ISlabLruCache;
+
+namespace {
+// 记录每次被赋值的对象地址，用来观察 slab 槽位是否被复用
+std::set<const void*> assignedSlots;
+
+struct Tracked {
+    int id = 0;
+    std::shared_ptr<int> payload;
+
+    Tracked() = default;
+    Tracked(int i) : id(i), payload(std::make_shared<int>(i)) {}
+    Tracked(const Tracked&) = default;
+    Tracked(Tracked&&) = default;
+
+    Tracked& operator=(const Tracked& other) {
+        assignedSlots.insert(this);
+        id = other.id;
+        payload = other.payload;
+        return *this;
+    }
+
+    Tracked& operator=(Tracked&& other) {
+        assignedSlots.insert(this);
+        id = other.id;
+        payload = std::move(other.payload);
+        return *this;
+    }
+};
+
+// remove 归还的槽位被之后的插入复用，槽位总数不超过容量
+void testReuseAfterRemove() {
+    ISlabLruCache<int, Tracked> cache(4);
+    for (int i = 0; i < 4; ++i) {
+        cache.insertOrAssign(i, Tracked(i));
+    }
+    for (int round = 0; round < 100; ++round) {
+        cache.remove(round % 4);
+        cache.insertOrAssign(round % 4, Tracked(round));
+    }
+    // 4 个槽位，remove 写入的空 value 也落在这些槽位上
+    CHECK(assignedSlots.size() == 4);
+    CHECK(cache.stats().size == 4);
+    CHECK(cache.stats().evictions == 0);
+    for (int i = 0; i < 4; ++i) {
+        Tracked value;
+        CHECK(cache.tryGet(i, value));
+        CHECK(value.id == 96 + i);
+    }
+}
+
+// 淘汰归还的槽位同样被复用
+void testReuseAfterEviction() {
+    assignedSlots.clear();
+    ISlabLruCache<int, Tracked> cache(4);
+    for (int i = 0; i < 100; ++i) {
+        cache.insertOrAssign(i, Tracked(i));
+    }
+    CHECK(assignedSlots.size() == 4);
+    CHECK(cache.stats().size == 4);
+    CHECK(cache.stats().evictions == 96);
+    Tracked value;
+    CHECK(!cache.tryGet(0, value));
+    CHECK(cache.tryGet(99, value) && value.id == 99);
+}
+
+// 被删除和被淘汰的 value 立即释放，不会留在空闲槽位里
+void testReleasedValues() {
+    ISlabLruCache<int, std::shared_ptr<int>> cache(2);
+    auto removed = std::make_shared<int>(1);
+    auto evicted = std::make_shared<int>(2);
+    std::weak_ptr<int> removedRef = removed;
+    std::weak_ptr<int> evictedRef = evicted;
+    cache.insertOrAssign(1, std::move(removed));
+    cache.insertOrAssign(2, std::move(evicted));
+    CHECK(!removedRef.expired());
+    CHECK(!evictedRef.expired());
+
+    cache.remove(1);
+    CHECK(removedRef.expired());
+
+    // 1 的槽位空闲，插入 3 不淘汰；插入 4 淘汰最久未访问的 2
+    cache.insertOrAssign(3, std::make_shared<int>(3));
+    CHECK(!evictedRef.expired());
+    cache.insertOrAssign(4, std::make_shared<int>(4));
+    CHECK(evictedRef.expired());
+}
+
+// 缩容淘汰的 value 同样立即释放
+void testReleasedOnShrink() {
+    ISlabLruCache<int, std::shared_ptr<int>> cache(8);
+    std::weak_ptr<int> oldest;
+    for (int i = 0; i < 8; ++i) {
+        auto value = std::make_shared<int>(i);
+        if (i == 0) {
+            oldest = value;
+        }
+        cache.insertOrAssign(i, std::move(value));
+    }
+    cache.setCapacity(4);
+    CHECK(oldest.expired());
+    CHECK(cache.stats().size == 4);
+}
+}  // namespace
+
+int main() {
+    testReuseAfterRemove();
+    testReuseAfterEviction();
+    testReleasedValues();
+    testReleasedOnShrink();
+    return IncreCacheTest::report("slabLruTest");
+}
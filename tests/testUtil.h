@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+// 测试用的最小断言：失败时打印位置并计数，main 返回失败数，ctest 据此判定
+namespace IncreCacheTest {
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline int report(const char* name) {
+    if (failures() == 0) {
+        std::cout << name << ": 全部通过" << std::endl;
+    } else {
+        std::cout << name << ": " << failures() << " 项失败" << std::endl;
+    }
+    return failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace IncreCacheTest
+
+#define CHECK(expr)                                                       \
+    do {                                                                  \
+        if (!(expr)) {                                                    \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #expr \
+                      << ") 失败" << std::endl;                           \
+            ++IncreCacheTest::failures();                                 \
+        }                                                                 \
+    } while (0)
@@ -0,0 +1,160 @@
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ILfuCache.h"
+#include "../ILruCache.h"
+#include "../ITimingWheel.h"
+#include "testUtil.h"
+
+using namespace IncreCache;
+using std::chrono::milliseconds;
+
+namespace {
+struct TimedItem {
+    TimerLink<TimedItem> timer;
+    uint64_t expireAt = 0;
+    uint64_t expiredAt = 0;  // 被回调的推进时刻，0 表示尚未到期
+};
+
+// 直接推进时间轮，时间由测试给出，结果不受调度影响：
+// 每个定时器恰好在第一次推进到不早于过期时刻时到期，
+// 跨越第 0 层（64 毫秒）以上的定时器逐层降级，不会提前也不会遗漏
+void testWheelCascade() {
+    TimingWheel<TimedItem> wheel;
+    uint64_t base = steadyNowMillis();
+    const uint64_t delays[] = {1,    63,    64,     65,      300,    4095,
+                               4096, 5000,  70000,  262143,  262144, 300000,
+                               20000000, 2000000000};
+    std::vector<TimedItem> items(std::size(delays));
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i].timer.owner = &items[i];
+        items[i].expireAt = base + delays[i];
+        wheel.schedule(&items[i].timer, items[i].expireAt);
+    }
+    CHECK(wheel.size() == items.size());
+
+    std::mt19937 gen(7);
+    uint64_t now = base;
+    size_t expired = 0;
+    while (expired < items.size()) {
+        // 步长有时很小、有时跨过整层，两种推进方式都要覆盖
+        uint64_t step = gen() % 4 == 0 ? gen() % 3000000 + 1 : gen() % 97 + 1;
+        now += step;
+        expired += wheel.advance(now, [now](TimedItem* item) {
+            item->expiredAt = now;
+        });
+        for (const TimedItem& item : items) {
+            // 已过期的一定已回调，未过期的一定还未回调
+            CHECK((item.expiredAt != 0) == (item.expireAt <= now));
+        }
+    }
+    CHECK(wheel.empty());
+}
+
+// 改期后按新的过期时刻到期
+void testWheelReschedule() {
+    TimingWheel<TimedItem> wheel;
+    uint64_t base = steadyNowMillis();
+    TimedItem item;
+    item.timer.owner = &item;
+    wheel.schedule(&item.timer, base + 10);
+    wheel.schedule(&item.timer, base + 500);
+    CHECK(wheel.size() == 1);
+    auto onExpire = [](TimedItem* expired) { expired->expiredAt = 1; };
+    CHECK(wheel.advance(base + 100, onExpire) == 0);
+    CHECK(wheel.advance(base + 499, onExpire) == 0);
+    CHECK(wheel.advance(base + 500, onExpire) == 1);
+    CHECK(item.expiredAt == 1);
+
+    wheel.schedule(&item.timer, base + 600);
+    wheel.cancel(&item.timer);
+    CHECK(wheel.advance(base + 1000, onExpire) == 0);
+    CHECK(wheel.empty());
+}
+
+// 存活时间内可读，过期后读不到并计入过期统计
+template <typename Cache>
+void testReadableUntilExpired() {
+    Cache cache(8);
+    cache.insertOrAssign(1, std::string("one"), milliseconds(100));
+    cache.insertOrAssign(2, std::string("two"));
+    std::string value;
+    CHECK(cache.tryGet(1, value) && value == "one");
+    std::this_thread::sleep_for(milliseconds(200));
+    CHECK(!cache.tryGet(1, value));
+    CHECK(cache.tryGet(2, value) && value == "two");
+    CHECK(cache.stats().expirations == 1);
+    CHECK(cache.stats().size == 1);
+}
+
+// 没有读写时由 purgeExpired 回收到期条目
+template <typename Cache>
+void testPurgeExpired() {
+    Cache cache(8);
+    for (int key = 0; key < 3; ++key) {
+        cache.insertOrAssign(key, std::to_string(key), milliseconds(50));
+    }
+    cache.insertOrAssign(3, std::string("3"));
+    CHECK(cache.purgeExpired() == 0);
+    std::this_thread::sleep_for(milliseconds(120));
+    CHECK(cache.purgeExpired() == 3);
+    CHECK(cache.purgeExpired() == 0);
+    CHECK(cache.stats().size == 1);
+}
+
+// 覆盖写入重新开始计时，旧的存活时间不会让新值提前过期；
+// 存活时间 0 取消已有的定时器
+template <typename Cache>
+void testOverwriteRestartsTtl() {
+    Cache cache(8);
+    cache.insertOrAssign(1, std::string("old"), milliseconds(80));
+    cache.insertOrAssign(2, std::string("old"), milliseconds(80));
+    std::this_thread::sleep_for(milliseconds(40));
+    cache.insertOrAssign(1, std::string("new"), milliseconds(400));
+    cache.insertOrAssign(2, std::string("new"), milliseconds(0));
+    std::this_thread::sleep_for(milliseconds(120));  // 已超过最初的 80 毫秒
+    std::string value;
+    CHECK(cache.tryGet(1, value) && value == "new");
+    CHECK(cache.tryGet(2, value) && value == "new");
+    CHECK(cache.stats().expirations == 0);
+    std::this_thread::sleep_for(milliseconds(400));
+    CHECK(!cache.tryGet(1, value));
+    CHECK(cache.tryGet(2, value) && value == "new");
+}
+
+// 存活时间超过第 0 层的跨度（64 毫秒），定时器从高层降级后按时到期
+template <typename Cache>
+void testTtlBeyondFirstLevel() {
+    Cache cache(8);
+    cache.insertOrAssign(1, std::string("one"), milliseconds(300));
+    std::string value;
+    for (int i = 0; i < 5; ++i) {
+        // 读写推进时间轮，定时器经过降级仍不提前到期
+        std::this_thread::sleep_for(milliseconds(30));
+        CHECK(cache.tryGet(1, value));
+    }
+    std::this_thread::sleep_for(milliseconds(350));
+    CHECK(!cache.tryGet(1, value));
+    CHECK(cache.stats().expirations == 1);
+}
+
+template <typename Cache>
+void testPolicy() {
+    testReadableUntilExpired<Cache>();
+    testPurgeExpired<Cache>();
+    testOverwriteRestartsTtl<Cache>();
+    testTtlBeyondFirstLevel<Cache>();
+}
+}  // namespace
+
+int main() {
+    testWheelCascade();
+    testWheelReschedule();
+    testPolicy<ILruCache<int, std::string>>();
+    testPolicy<ILfuCache<int, std::string>>();
+    return IncreCacheTest::report("ttlTest");
+}
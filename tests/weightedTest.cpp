@@ -0,0 +1,85 @@
+#include <random>
+#include <string>
+
+#include "../IArcCache/IArcCache.h"
+#include "../ILfuCache.h"
+#include "../ILruCache.h"
+#include "testUtil.h"
+
+using namespace IncreCache;
+
+namespace {
+constexpr size_t kMaxWeight = 8192;
+
+size_t valueBytes(const int&, const std::string& value) {
+    return value.size();
+}
+
+// 写入大小不一的值（包括覆盖成更大的值），每次写入之后总权重不超过预算
+template <typename Cache>
+void testWeightWithinBudget(Cache& cache) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> keyDist(0, 199);
+    std::uniform_int_distribution<size_t> sizeDist(1, 600);
+    for (int op = 0; op < 5000; ++op) {
+        int key = keyDist(gen);
+        if (gen() % 4 == 0) {
+            std::string value;
+            if (cache.tryGet(key, value)) {
+                CHECK(value.size() >= 1 && value[0] == 'a' + key % 26);
+            }
+            continue;
+        }
+        cache.put(key, std::string(sizeDist(gen), 'a' + key % 26));
+        CacheStats stats = cache.stats();
+        CHECK(stats.weight <= kMaxWeight);
+        CHECK(stats.size > 0);
+    }
+    CHECK(cache.stats().evictions > 0);
+
+    // 单个条目超过整个预算时不缓存，也不把已有条目挤出去
+    size_t before = cache.stats().size;
+    cache.put(1000, std::string(kMaxWeight + 1, 'x'));
+    std::string value;
+    CHECK(!cache.tryGet(1000, value));
+    CHECK(cache.stats().weight <= kMaxWeight);
+    CHECK(cache.stats().size == before);
+}
+
+void testLru() {
+    ILruCache<int, std::string> cache(kMaxWeight, valueBytes);
+    testWeightWithinBudget(cache);
+}
+
+void testLfu() {
+    ILfuCache<int, std::string> cache(kMaxWeight, valueBytes);
+    testWeightWithinBudget(cache);
+}
+
+void testArc() {
+    IArcCache<int, std::string> cache(kMaxWeight, valueBytes);
+    testWeightWithinBudget(cache);
+}
+
+// 缩容后的分批淘汰结束时总权重回到新预算以内
+void testShrinkBudget() {
+    ILruCache<int, std::string> cache(kMaxWeight, valueBytes);
+    for (int key = 0; key < 100; ++key) {
+        cache.put(key, std::string(100, 'v'));
+    }
+    cache.setCapacity(kMaxWeight / 4);
+    std::string value;
+    for (int n = 0; n < 100; ++n) {
+        cache.tryGet(n, value);
+    }
+    CHECK(cache.stats().weight <= kMaxWeight / 4);
+}
+}  // namespace
+
+int main() {
+    testLru();
+    testLfu();
+    testArc();
+    testShrinkBudget();
+    return IncreCacheTest::report("weightedTest");
+}